@@ -1,11 +1,38 @@
 #!/bin/bash
 
+# quick debug build into bin/; CMakeLists.txt has the optimized, PGO and sanitizer variants (see build_variants.sh)
+
 if [ ! -d "bin" ]; then
     mkdir bin
 else
 	rm bin/*
 fi
 
-g++ -g -O0 -I . -o bin/interrupts_EP_101268848_101281787.cpp interrupts_EP_101268848_101281787.cpp
-g++ -g -O0 -I . -o bin/interrupts_RR_101268848_101281787.cpp interrupts_RR_101268848_101281787.cpp
-g++ -g -O0 -I . -o bin/interrupts_EP_RR_101268848_101281787.cpp interrupts_EP_RR_101268848_101281787.cpp
\ No newline at end of file
+# the simulator library: the OS side plus every scheduling policy
+for src in simulator_101268848_101281787.cpp scheduler_*_101268848_101281787.cpp; do
+    g++ -std=c++17 -g -O0 -I . -pthread -c -o bin/$(basename $src .cpp).o $src
+done
+ar rcs bin/libsimulator_101268848_101281787.a bin/*.o
+rm bin/*.o
+
+g++ -g -O0 -I . -pthread -o bin/interrupts_EP_101268848_101281787 interrupts_EP_101268848_101281787.cpp bin/libsimulator_101268848_101281787.a
+g++ -g -O0 -I . -pthread -o bin/interrupts_RR_101268848_101281787 interrupts_RR_101268848_101281787.cpp bin/libsimulator_101268848_101281787.a
+g++ -g -O0 -I . -pthread -o bin/interrupts_EP_RR_101268848_101281787 interrupts_EP_RR_101268848_101281787.cpp bin/libsimulator_101268848_101281787.a
+g++ -g -O0 -I . -pthread -o bin/interrupts_MLFQ_101268848_101281787 interrupts_MLFQ_101268848_101281787.cpp bin/libsimulator_101268848_101281787.a
+g++ -g -O0 -I . -pthread -o bin/interrupts_SRTF_101268848_101281787 interrupts_SRTF_101268848_101281787.cpp bin/libsimulator_101268848_101281787.a
+g++ -g -O0 -I . -pthread -o bin/interrupts_CFS_101268848_101281787 interrupts_CFS_101268848_101281787.cpp bin/libsimulator_101268848_101281787.a
+g++ -g -O0 -I . -pthread -o bin/interrupts_EDF_101268848_101281787 interrupts_EDF_101268848_101281787.cpp bin/libsimulator_101268848_101281787.a
+g++ -g -O0 -I . -pthread -o bin/interrupts_STRIDE_101268848_101281787 interrupts_STRIDE_101268848_101281787.cpp bin/libsimulator_101268848_101281787.a
+g++ -g -O0 -I . -pthread -o bin/interrupts_BATCH_101268848_101281787 interrupts_BATCH_101268848_101281787.cpp bin/libsimulator_101268848_101281787.a
+g++ -g -O0 -I . -pthread -o bin/interrupts_CLUSTER_101268848_101281787 interrupts_CLUSTER_101268848_101281787.cpp bin/libsimulator_101268848_101281787.a
+g++ -g -O0 -I . -pthread -o bin/interrupts_SERVER_101268848_101281787 interrupts_SERVER_101268848_101281787.cpp bin/libsimulator_101268848_101281787.a
+g++ -g -O0 -I . -pthread -o bin/interrupts_GANTT_101268848_101281787 interrupts_GANTT_101268848_101281787.cpp bin/libsimulator_101268848_101281787.a
+g++ -g -O0 -I . -pthread -o bin/interrupts_QUERY_101268848_101281787 interrupts_QUERY_101268848_101281787.cpp bin/libsimulator_101268848_101281787.a
+g++ -g -O0 -I . -pthread -o bin/interrupts_REPORT_101268848_101281787 interrupts_REPORT_101268848_101281787.cpp bin/libsimulator_101268848_101281787.a
+g++ -g -O0 -I . -pthread -o bin/interrupts_DIFF_101268848_101281787 interrupts_DIFF_101268848_101281787.cpp bin/libsimulator_101268848_101281787.a
+
+# ring buffer throughput and correctness check: ./bin/queue_bench [items]
+g++ -std=c++17 -O2 -I . -pthread -o bin/queue_bench_101268848_101281787 queue_bench_101268848_101281787.cpp
+
+# synthetic workloads: ./bin/workload_gen <processes> [seed] [--devices=<n>]
+g++ -std=c++17 -O2 -I . -o bin/workload_gen_101268848_101281787 workload_gen_101268848_101281787.cpp
@@ -0,0 +1,87 @@
+#!/bin/bash
+
+# Builds every variant of CMakeLists.txt, one directory each under build/, runs the test inputs under the
+# sanitizers and benchmarks the rest on generated workloads, so production runs can take the fastest:
+#   ./build_variants.sh [processes]
+# processes (default 5000) sizes the benchmark workload; EP, RR and EP_RR, which are quadratic in it, get a
+# quarter. Each binary runs 3 times and keeps its best time. The table goes to build/benchmarks.txt as well.
+
+set -e
+processes=${1:-5000}
+jobs=$(nproc)
+root=$(cd "$(dirname "$0")" && pwd)
+build=$root/build
+policies="EP RR EP_RR MLFQ SRTF CFS EDF STRIDE"
+benchmarked="debug release pgo"
+
+configure_and_build() {     # <variant> [cmake options]
+    local dir=$build/$1
+    shift
+    cmake -S "$root" -B "$dir" "$@" > /dev/null
+    cmake --build "$dir" -j"$jobs" > /dev/null
+}
+
+echo "Building debug and release"
+configure_and_build debug -DCMAKE_BUILD_TYPE=Debug -DSIM_PGO=OFF -DSIM_SANITIZE=
+configure_and_build release -DCMAKE_BUILD_TYPE=Release -DSIM_PGO=OFF -DSIM_SANITIZE=
+
+# both passes in the same directory, the profiles are named after the object files
+echo "Building pgo: instrumented build, training, optimized build"
+rm -rf "$build/pgo/pgo-profiles"
+configure_and_build pgo -DCMAKE_BUILD_TYPE=Release -DSIM_PGO=GENERATE -DSIM_SANITIZE=
+cmake --build "$build/pgo" --target pgo-train > /dev/null
+configure_and_build pgo -DSIM_PGO=USE
+
+for sanitizer in asan:address,undefined tsan:thread; do
+    echo "Building ${sanitizer%%:*} and running the test inputs"
+    configure_and_build "${sanitizer%%:*}" -DCMAKE_BUILD_TYPE=Debug -DSIM_PGO=OFF -DSIM_SANITIZE="${sanitizer#*:}"
+    ctest --test-dir "$build/${sanitizer%%:*}" -j"$jobs" --output-on-failure > "$build/${sanitizer%%:*}/ctest.log" ||
+        { tail -40 "$build/${sanitizer%%:*}/ctest.log"; echo "${sanitizer%%:*}: the test inputs failed"; exit 1; }
+    tail -3 "$build/${sanitizer%%:*}/ctest.log" | head -1
+done
+
+# a workload the training never saw
+bench=$build/bench
+mkdir -p "$bench"
+"$build/release/workload_gen_101268848_101281787" "$processes" 7 > "$bench/large.txt"
+"$build/release/workload_gen_101268848_101281787" $((processes / 4)) 8 > "$bench/small.txt"
+
+best_ms() {     # <binary> <workload>: best of 3 wall-clock runs in ms
+    local best=
+    for run in 1 2 3; do
+        local start=$(date +%s%N)
+        (cd "$bench" && "$1" "$2" > /dev/null)
+        local ms=$(( ($(date +%s%N) - start) / 1000000 ))
+        [ -z "$best" ] || [ "$ms" -lt "$best" ] && best=$ms
+    done
+    echo "$best"
+}
+
+echo "Benchmarking on $processes generated processes ($((processes / 4)) for EP, RR and EP_RR)"
+report=$build/benchmarks.txt
+{
+    printf "%-10s" "ms"
+    for variant in $benchmarked; do printf "%10s" "$variant"; done
+    printf "\n"
+} > "$report"
+declare -A total
+for policy in $policies; do
+    workload=large.txt
+    case $policy in EP|RR|EP_RR) workload=small.txt ;; esac
+    row=$(printf "%-10s" "$policy")
+    for variant in $benchmarked; do
+        ms=$(best_ms "$build/$variant/interrupts_${policy}_101268848_101281787" "$workload")
+        total[$variant]=$(( ${total[$variant]:-0} + ms ))
+        row+=$(printf "%10s" "$ms")
+    done
+    echo "$row" >> "$report"
+done
+fastest=
+row=$(printf "%-10s" "total")
+for variant in $benchmarked; do
+    row+=$(printf "%10s" "${total[$variant]}")
+    [ -z "$fastest" ] || [ "${total[$variant]}" -lt "${total[$fastest]}" ] && fastest=$variant
+done
+echo "$row" >> "$report"
+echo "fastest: $fastest, binaries in build/$fastest" >> "$report"
+cat "$report"
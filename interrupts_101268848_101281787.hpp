@@ -17,6 +17,28 @@
 #include<sstream>
 #include<iomanip>
 #include<algorithm>
+#include<cstdint>
+#include<chrono>
+#include<functional>
+#include<unordered_map>
+#include<map>
+#include<set>
+#include<list>
+#include<queue>
+#include<climits>
+#include<cmath>
+#include<cstring>
+#include<stdexcept>
+#include<atomic>
+#include<thread>
+#include<mutex>
+#include<type_traits>
+#include<filesystem>
+#include<memory>
+#include<array>
+#include<charconv>
+#include<limits>
+#include<cctype>
 
 //An enumeration of states to make assignment easier
 enum states {
@@ -25,26 +47,20 @@ enum states {
     RUNNING,
     WAITING,
     TERMINATED,
-    NOT_ASSIGNED
+    NOT_ASSIGNED,
+    SUSPENDED_READY,    // swapped out by the medium-term scheduler, runnable once swapped back in
+    SUSPENDED_WAITING   // swapped out while its I/O is in progress
 };
-std::ostream& operator<<(std::ostream& os, const enum states& s) { //Overloading the << operator to make printing of the enum easier
-
-	std::string state_names[] = {
-                                "NEW",
-                                "READY",
-                                "RUNNING",
-                                "WAITING",
-                                "TERMINATED",
-                                "NOT_ASSIGNED"
-    };
-    return (os << state_names[s]);
-}
+std::ostream& operator<<(std::ostream& os, const enum states& s); //Overloading the << operator to make printing of the enum easier
 
 struct memory_partition{
     unsigned int    partition_number;
     unsigned int    size;
     int             occupied;
-} memory_paritions[] = {
+};
+
+//Layout of the fixed-partition model; every Simulator starts from its own copy
+const memory_partition DEFAULT_PARTITIONS[] = {
     {1, 40, -1},
     {2, 25, -1},
     {3, 15, -1},
@@ -64,254 +80,1755 @@ struct PCB{
     enum states     state;
     unsigned int    io_freq;
     unsigned int    io_duration;
+    int             nice;           // optional 7th input column, -20..19 (default 0)
+    unsigned int    deadline;       // optional 8th input column, relative to arrival (0 = none)
+    unsigned int    tickets;        // optional 9th input column, proportional share (default 100)
+    int             device;         // optional 10th input column, index of the --device its I/O goes to (default 0)
 };
 
-//------------------------------------HELPER FUNCTIONS FOR THE SIMULATOR------------------------------
-// Following function was taken from stackoverflow; helper function for splitting strings
-std::vector<std::string> split_delim(std::string input, std::string delim) {
-    std::vector<std::string> tokens;
-    std::size_t pos = 0;
-    std::string token;
-    while ((pos = input.find(delim)) != std::string::npos) {
-        token = input.substr(0, pos);
-        tokens.push_back(token);
-        input.erase(0, pos + delim.length());
-    }
-    tokens.push_back(input);
-
-    return tokens;
-}
+//Per-process accounting built from the state transitions of a simulation
+struct process_metrics {
+    int             PID;
+    unsigned int    arrival_time;
+    enum states     state;              // state since last_transition
+    unsigned int    last_transition;
+    int             response_time;      // arrival -> first READY->RUNNING, -1 until dispatched
+    int             finish_time;        // -1 until TERMINATED
+    unsigned int    admission_time;     // time spent NOT_ASSIGNED waiting for a partition
+    unsigned int    ready_time;
+    unsigned int    cpu_time;
+    unsigned int    io_time;
+    unsigned int    suspended_time;     // time swapped out to the backing store
+    unsigned int    deadline;           // absolute deadline, 0 if the process has none
+};
 
-//Function that takes a queue as an input and outputs a string table of PCBs
-std::string print_PCB(std::vector<PCB> _PCB) {
-    const int tableWidth = 83;
-
-    std::stringstream buffer;
-    
-    // Print top border
-    buffer << "+" << std::setfill('-') << std::setw(tableWidth) << "+" << std::endl;
-    
-    // Print headers
-    buffer << "|"
-              << std::setfill(' ') << std::setw(4) << "PID"
-              << std::setw(2) << "|"
-              << std::setfill(' ') << std::setw(11) << "Partition"
-              << std::setw(2) << "|"
-              << std::setfill(' ') << std::setw(5) << "Size"
-              << std::setw(2) << "|"
-              << std::setfill(' ') << std::setw(13) << "Arrival Time"
-              << std::setw(2) << "|"
-              << std::setfill(' ') << std::setw(11) << "Start Time"
-              << std::setw(2) << "|"
-              << std::setfill(' ') << std::setw(14) << "Remaining Time"
-              << std::setw(2) << "|"
-              << std::setfill(' ') << std::setw(11) << "State"
-              << std::setw(2) << "|" << std::endl;
-    
-    // Print separator
-    buffer << "+" << std::setfill('-') << std::setw(tableWidth) << "+" << std::endl;
-    
-    // Print each PCB entry
-    for (const auto& program : _PCB) {
-        buffer << "|"
-                  << std::setfill(' ') << std::setw(4) << program.PID
-                  << std::setw(2) << "|"
-                  << std::setw(11) << program.partition_number
-                  << std::setw(2) << "|"
-                  << std::setw(5) << program.size
-                  << std::setw(2) << "|"
-                  << std::setw(13) << program.arrival_time
-                  << std::setw(2) << "|"
-                  << std::setw(11) << program.start_time
-                  << std::setw(2) << "|"
-                  << std::setw(14) << program.remaining_time
-                  << std::setw(2) << "|"
-                  << std::setw(11) << program.state
-                  << std::setw(2) << "|" << std::endl;
-    }
-    
-    // Print bottom border
-    buffer << "+" << std::setfill('-') << std::setw(tableWidth) << "+" << std::endl;
-
-    return buffer.str();
+//-------------------------------------------CHECKPOINT ARCHIVE------------------------------------------
+//Binary archive for checkpoints. Each piece of simulator state is listed once, in an archive(ar, x) overload or
+//a serialize(ar) member, and the mode decides whether it is written, read back, or written in the canonical
+//digest form used to compare the state of two runs (history such as logs and statistics is left out).
+class state_archive {
+public:
+    enum modes {
+        SAVE,
+        LOAD,
+        DIGEST
+    };
+
+    explicit state_archive(modes mode, std::string bytes = "") : mode(mode), bytes(std::move(bytes)) {}
+
+    bool loading() const { return mode == LOAD; }
+    bool digest() const { return mode == DIGEST; }
+    const std::string &data() const { return bytes; }
+    bool exhausted() const { return position == bytes.size(); }
+
+    void raw(void *data, std::size_t n) {
+        if (mode != LOAD) {
+            bytes.append(static_cast<const char*>(data), n);
+            return;
+        }
+        if (position + n > bytes.size()) throw std::runtime_error("checkpoint is truncated");
+        std::memcpy(data, bytes.data() + position, n);
+        position += n;
+    }
+
+private:
+    modes mode;
+    std::string bytes;
+    std::size_t position = 0;
+};
+
+template <typename T>
+typename std::enable_if<std::is_trivially_copyable<T>::value>::type archive(state_archive &ar, T &value) {
+    ar.raw(&value, sizeof(T));
 }
 
-//Overloaded function that takes a single PCB as input
-std::string print_PCB(PCB _PCB) {
-    std::vector<PCB> temp;
-    temp.push_back(_PCB);
-    return print_PCB(temp);
+template <typename T>
+auto archive(state_archive &ar, T &value) -> decltype(value.serialize(ar), void()) {
+    value.serialize(ar);
 }
 
-std::string print_exec_header() {
-
-    const int tableWidth = 49;
-
-    std::stringstream buffer;
-    
-    // Print top border
-    buffer << "+" << std::setfill('-') << std::setw(tableWidth) << "+" << std::endl;
-    
-    // Print headers
-    buffer  << "|"
-            << std::setfill(' ') << std::setw(18) << "Time of Transition"
-            << std::setw(2) << "|"
-            << std::setfill(' ') << std::setw(3) << "PID"
-            << std::setw(2) << "|"
-            << std::setfill(' ') << std::setw(10) << "Old State"
-            << std::setw(2) << "|"
-            << std::setfill(' ') << std::setw(10) << "New State"
-            << std::setw(2) << "|" << std::endl;
-    
-    // Print separator
-    buffer << "+" << std::setfill('-') << std::setw(tableWidth) << "+" << std::endl;
-
-    return buffer.str();
+// declared up front so the container overloads can nest in any order
+void archive(state_archive &ar, std::string &value);
+template <typename A, typename B> void archive(state_archive &ar, std::pair<A, B> &value);
+template <typename... T> void archive(state_archive &ar, std::tuple<T...> &value);
+template <typename T> void archive(state_archive &ar, std::vector<T> &values);
+void archive(state_archive &ar, std::vector<bool> &values);
+template <typename T> void archive(state_archive &ar, std::list<T> &values);
+template <typename T> void archive(state_archive &ar, std::set<T> &values);
+template <typename K, typename V> void archive(state_archive &ar, std::map<K, V> &values);
+template <typename K, typename V> void archive(state_archive &ar, std::unordered_map<K, V> &values);
 
+//Statistics and logs: saved and restored, but not part of a digest
+template <typename T>
+void archive_history(state_archive &ar, T &value) {
+    if (!ar.digest()) archive(ar, value);
+}
+template <typename A, typename B>
+void archive(state_archive &ar, std::pair<A, B> &value) {
+    archive(ar, value.first);
+    archive(ar, value.second);
 }
 
-std::string print_exec_status(unsigned int current_time, int PID, states old_state, states new_state) {
+template <typename... T>
+void archive(state_archive &ar, std::tuple<T...> &value) {
+    std::apply([&](auto &... fields){ (archive(ar, fields), ...); }, value);
+}
 
-    const int tableWidth = 49;
+template <typename T>
+void archive(state_archive &ar, std::vector<T> &values) {
+    uint64_t n = values.size();
+    archive(ar, n);
+    if (ar.loading()) values.resize(n);
+    for (auto &value : values) archive(ar, value);
+}
+template <typename T>
+void archive(state_archive &ar, std::list<T> &values) {
+    std::vector<T> items(values.begin(), values.end());
+    archive(ar, items);
+    if (ar.loading()) values.assign(items.begin(), items.end());
+}
 
-    std::stringstream buffer;
+template <typename T>
+void archive(state_archive &ar, std::set<T> &values) {
+    std::vector<T> items(values.begin(), values.end());
+    archive(ar, items);
+    if (ar.loading()) values = std::set<T>(items.begin(), items.end());
+}
 
-    buffer  << "|"
-            << std::setfill(' ') << std::setw(18) << current_time
-            << std::setw(2) << "|"
-            << std::setw(3) << PID
-            << std::setw(2) << "|"
-            << std::setw(10) << old_state
-            << std::setw(2) << "|"
-            << std::setw(10) << new_state
-            << std::setw(2) << "|" << std::endl;
+template <typename K, typename V>
+void archive(state_archive &ar, std::map<K, V> &values) {
+    std::vector<std::pair<K, V>> items(values.begin(), values.end());
+    archive(ar, items);
+    if (ar.loading()) values = std::map<K, V>(items.begin(), items.end());
+}
 
-    return buffer.str();
+//Written sorted by key, so equal maps give equal bytes whatever their insertion history
+template <typename K, typename V>
+void archive(state_archive &ar, std::unordered_map<K, V> &values) {
+    std::vector<std::pair<K, V>> items(values.begin(), values.end());
+    std::sort(items.begin(), items.end(), [](const std::pair<K, V> &a, const std::pair<K, V> &b){ return a.first < b.first; });
+    archive(ar, items);
+    if (ar.loading()) values = std::unordered_map<K, V>(items.begin(), items.end());
 }
 
-std::string print_exec_footer() {
-    const int tableWidth = 49;
-    std::stringstream buffer;
+//A terminated process no longer influences the run, so a digest only keeps its PID and state
+void archive(state_archive &ar, PCB &process);
 
-    // Print bottom border
-    buffer << "+" << std::setfill('-') << std::setw(tableWidth) << "+" << std::endl;
+//------------------------------------DATA STRUCTURES FOR THE SCHEDULERS-----------------------------
+//Growable ring buffer used as an O(1) FIFO queue (push at the back, pop from the front)
+template <typename T>
+class ring_queue {
+public:
+    bool empty() const { return count == 0; }
+    std::size_t size() const { return count; }
 
-    return buffer.str();
-}
+    T &front() { return buffer[head]; }
 
-//Synchronize the process in the process queue
-void sync_queue(std::vector<PCB> &process_queue, PCB _process) {
-    for(auto &process : process_queue) {
-        if(process.PID == _process.PID) {
-            process = _process;
+    void push_back(const T &value) {
+        if (count == buffer.size()) grow();
+        buffer[(head + count) & (buffer.size() - 1)] = value;
+        count++;
+    }
+
+    void pop_front() {
+        head = (head + 1) & (buffer.size() - 1);
+        count--;
+    }
+
+    template <typename Archive>
+    void serialize(Archive &ar) {
+        std::vector<T> items;
+        for (std::size_t i = 0; i < count; i++) items.push_back(buffer[(head + i) & (buffer.size() - 1)]);
+        archive(ar, items);
+        if (ar.loading()) {
+            buffer.clear();
+            head = count = 0;
+            for (auto &item : items) push_back(item);
         }
     }
-}
 
-//Writes a string to a file
-void write_output(std::string execution, const char* filename) {
-    std::ofstream output_file(filename);
+private:
+    //Capacity is always a power of two so wrapping is a mask instead of a modulo
+    void grow() {
+        std::vector<T> bigger(buffer.empty() ? 16 : buffer.size() * 2);
+        for (std::size_t i = 0; i < count; i++) {
+            bigger[i] = buffer[(head + i) & (buffer.size() - 1)];
+        }
+        buffer.swap(bigger);
+        head = 0;
+    }
+
+    std::vector<T> buffer;
+    std::size_t head = 0;
+    std::size_t count = 0;
+};
+
+//Binary min-heap over item ids (e.g. indices into the process list) with a position index,
+//so an item already in the heap can have its key changed or be removed in O(log n)
+template <typename Key, typename Compare = std::less<Key>>
+class indexed_heap {
+public:
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+    bool empty() const { return heap.empty(); }
+    std::size_t size() const { return heap.size(); }
+
+    bool contains(std::size_t id) const { return id < position.size() && position[id] != npos; }
+    std::size_t top() const { return heap.front(); }
+    const Key &key(std::size_t id) const { return keys[id]; }
 
-    if (output_file.is_open()) {
-        output_file << execution;
-        output_file.close();  // Close the file when done
-        std::cout << "File content overwritten successfully." << std::endl;
-    } else {
-        std::cerr << "Error opening file!" << std::endl;
+    void push(std::size_t id, const Key &key) {
+        if (id >= position.size()) {
+            keys.resize(id + 1);
+            position.resize(id + 1, npos);
+        }
+        keys[id] = key;
+        position[id] = heap.size();
+        heap.push_back(id);
+        sift_up(heap.size() - 1);
+    }
+
+    //Change the key of an item already in the heap (decrease-key or increase-key)
+    void update(std::size_t id, const Key &key) {
+        bool decreased = compare(key, keys[id]);
+        keys[id] = key;
+        if (decreased) sift_up(position[id]);
+        else sift_down(position[id]);
     }
 
-    std::cout << "Output generated in " << filename << ".txt" << std::endl;
+    std::size_t pop() {
+        std::size_t id = heap.front();
+        erase(id);
+        return id;
+    }
+
+    //Keys are (value, sequence) pairs in every scheduler and only the order of the sequences matters, so a
+    //digest keeps the members in priority order with just their values
+    template <typename Archive>
+    void serialize(Archive &ar) {
+        if (ar.digest()) {
+            std::vector<std::size_t> members(heap);
+            std::sort(members.begin(), members.end(), [&](std::size_t a, std::size_t b){ return compare(keys[a], keys[b]); });
+            archive(ar, members);
+            for (auto id : members) archive(ar, keys[id].first);
+            return;
+        }
+        archive(ar, heap);
+        archive(ar, position);
+        archive(ar, keys);
+    }
+
+    void erase(std::size_t id) {
+        std::size_t pos = position[id];
+        std::size_t last = heap.back();
+        heap.pop_back();
+        position[id] = npos;
+        if (last != id) {
+            heap[pos] = last;
+            position[last] = pos;
+            sift_up(pos);
+            sift_down(position[last]);
+        }
+    }
+
+private:
+    void place(std::size_t pos, std::size_t id) {
+        heap[pos] = id;
+        position[id] = pos;
+    }
+
+    void sift_up(std::size_t pos) {
+        std::size_t id = heap[pos];
+        while (pos > 0) {
+            std::size_t parent = (pos - 1) / 2;
+            if (!compare(keys[id], keys[heap[parent]])) break;
+            place(pos, heap[parent]);
+            pos = parent;
+        }
+        place(pos, id);
+    }
+
+    void sift_down(std::size_t pos) {
+        std::size_t id = heap[pos];
+        while (true) {
+            std::size_t child = 2 * pos + 1;
+            if (child >= heap.size()) break;
+            if (child + 1 < heap.size() && compare(keys[heap[child + 1]], keys[heap[child]])) child++;
+            if (!compare(keys[heap[child]], keys[id])) break;
+            place(pos, heap[child]);
+            pos = child;
+        }
+        place(pos, id);
+    }
+
+    std::vector<std::size_t> heap;      // ids in heap order
+    std::vector<std::size_t> position;  // id -> index in heap, npos if absent
+    std::vector<Key> keys;              // id -> key
+    Compare compare;
+};
+
+//Fenwick (binary indexed) tree of non-negative weights, e.g. lottery tickets per process.
+//add() and find() are O(log n): find(r) returns the item whose cumulative weight range contains r.
+class fenwick_tree {
+public:
+    explicit fenwick_tree(std::size_t n) : tree(n + 1, 0), highest_bit(1) {
+        while (highest_bit * 2 <= n) highest_bit *= 2;
+    }
+
+    uint64_t total() const { return sum; }
+
+    //weight[0] + ... + weight[n - 1]
+    uint64_t prefix(std::size_t n) const {
+        uint64_t total = 0;
+        for (; n > 0; n -= n & (~n + 1)) total += tree[n];
+        return total;
+    }
+
+    //Append an element of weight 0
+    void push_back() {
+        std::size_t i = tree.size();
+        tree.push_back(prefix(i - 1) - prefix(i - (i & (~i + 1))));
+        if (highest_bit * 2 <= i) highest_bit *= 2;
+    }
+
+    void add(std::size_t i, int64_t delta) {
+        sum += delta;
+        for (i++; i < tree.size(); i += i & (~i + 1)) tree[i] += delta;
+    }
+
+    //Smallest i such that weight[0] + ... + weight[i] > r, for 0 <= r < total()
+    std::size_t find(uint64_t r) const {
+        std::size_t pos = 0;
+        for (std::size_t step = highest_bit; step > 0; step /= 2) {
+            if (pos + step < tree.size() && tree[pos + step] <= r) {
+                pos += step;
+                r -= tree[pos];
+            }
+        }
+        return pos;
+    }
+
+    template <typename Archive>
+    void serialize(Archive &ar) {
+        archive(ar, tree);
+        archive(ar, highest_bit);
+        archive(ar, sum);
+    }
+
+private:
+    std::vector<uint64_t> tree;     // 1-based
+    std::size_t highest_bit;
+    uint64_t sum = 0;
+};
+
+//Size the producer and consumer sides of the rings below are padded to, so they never share a cache line
+const std::size_t CACHE_LINE_SIZE = 64;
+
+//Bounded single-producer single-consumer ring buffer, the lock-free hand-off between pipeline stages on two threads.
+//The capacity is rounded up to a power of two. Each index sits on its own cache line and each side keeps a copy of
+//the other side's index, so the shared line is only read again when the ring looks full (or empty).
+template <typename T>
+class spsc_ring {
+public:
+    explicit spsc_ring(std::size_t capacity) {
+        std::size_t size = 1;
+        while (size < capacity) size <<= 1;
+        slots.resize(size);
+        mask = size - 1;
+    }
+
+    //Producer side
+    bool try_push(const T &value) {
+        std::size_t write = write_index.load(std::memory_order_relaxed);
+        if (write - read_seen > mask) {
+            read_seen = read_index.load(std::memory_order_acquire);
+            if (write - read_seen > mask) return false;
+        }
+        slots[write & mask] = value;
+        write_index.store(write + 1, std::memory_order_release);
+        return true;
+    }
+
+    void push(const T &value) {
+        while (!try_push(value)) std::this_thread::yield();
+    }
+
+    //No more pushes; pop() returns false once the rest is drained
+    void close() {
+        closed.store(true, std::memory_order_release);
+    }
+
+    //Consumer side
+    bool try_pop(T &value) {
+        std::size_t read = read_index.load(std::memory_order_relaxed);
+        if (read == write_seen) {
+            write_seen = write_index.load(std::memory_order_acquire);
+            if (read == write_seen) return false;
+        }
+        value = std::move(slots[read & mask]);
+        read_index.store(read + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool pop(T &value) {
+        while (!try_pop(value)) {
+            // a push before close() is visible once closed is
+            if (closed.load(std::memory_order_acquire)) return try_pop(value);
+            std::this_thread::yield();
+        }
+        return true;
+    }
+
+private:
+    std::vector<T> slots;
+    std::size_t mask;
+    alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> write_index{0};
+    std::size_t read_seen = 0;                          // producer's copy of read_index
+    alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> read_index{0};
+    std::size_t write_seen = 0;                         // consumer's copy of write_index
+    alignas(CACHE_LINE_SIZE) std::atomic<bool> closed{false};
+};
+
+//Bounded multi-producer single-consumer ring buffer (Vyukov's bounded queue with a single consumer). Producers
+//claim a slot with one compare-and-swap on the write index; every slot carries a sequence number that says
+//whether it is free for the lap a producer is on or holds a value for the consumer's lap, so a producer never
+//waits for another one to finish its copy. close() must come after every producer is done.
+template <typename T>
+class mpsc_ring {
+public:
+    explicit mpsc_ring(std::size_t capacity) {
+        std::size_t size = 1;
+        while (size < capacity) size <<= 1;
+        slots.reset(new slot[size]);
+        mask = size - 1;
+        for (std::size_t i = 0; i < size; i++) slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    //Producer side, from any thread
+    bool try_push(const T &value) {
+        std::size_t write = write_index.load(std::memory_order_relaxed);
+        for (;;) {
+            slot &s = slots[write & mask];
+            std::size_t sequence = s.sequence.load(std::memory_order_acquire);
+            std::ptrdiff_t lap = (std::ptrdiff_t)(sequence - write);
+            if (lap == 0) {
+                if (write_index.compare_exchange_weak(write, write + 1, std::memory_order_relaxed)) {
+                    s.value = value;
+                    s.sequence.store(write + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (lap < 0) {
+                return false;   // the consumer has not freed this slot yet: full
+            } else {
+                write = write_index.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    void push(const T &value) {
+        while (!try_push(value)) std::this_thread::yield();
+    }
+
+    void close() {
+        closed.store(true, std::memory_order_release);
+    }
+
+    //Consumer side
+    bool try_pop(T &value) {
+        slot &s = slots[read_index & mask];
+        if (s.sequence.load(std::memory_order_acquire) != read_index + 1) return false;
+        value = std::move(s.value);
+        s.sequence.store(read_index + mask + 1, std::memory_order_release);    // free for the next lap
+        read_index++;
+        return true;
+    }
+
+    bool pop(T &value) {
+        while (!try_pop(value)) {
+            if (closed.load(std::memory_order_acquire)) return try_pop(value);
+            std::this_thread::yield();
+        }
+        return true;
+    }
+
+private:
+    struct slot {
+        std::atomic<std::size_t>    sequence;
+        T                           value;
+    };
+
+    std::unique_ptr<slot[]> slots;
+    std::size_t mask;
+    alignas(CACHE_LINE_SIZE) std::atomic<std::size_t> write_index{0};
+    alignas(CACHE_LINE_SIZE) std::size_t read_index = 0;    // consumer only
+    alignas(CACHE_LINE_SIZE) std::atomic<bool> closed{false};
+};
+
+//Runs work(0) .. work(count - 1) on threads workers (the calling thread is one of them), each claiming the next
+//index, so uneven items balance out
+template <typename Work>
+void parallel_for(size_t count, unsigned int threads, Work work) {
+    std::atomic<size_t> next(0);
+    auto worker = [&](){
+        for (size_t i; (i = next++) < count;) work(i);
+    };
+    std::vector<std::thread> pool;
+    for (unsigned int t = 1; t < threads; t++) pool.emplace_back(worker);
+    worker();
+    for (auto &thread : pool) thread.join();
 }
 
+//------------------------------------HELPER FUNCTIONS FOR THE SIMULATOR------------------------------
+// Following function was taken from stackoverflow; helper function for splitting strings
+std::vector<std::string> split_delim(std::string input, std::string delim);
+
+//Function that takes a queue as an input and outputs a string table of PCBs
+std::string print_PCB(std::vector<PCB> _PCB);
+
+//Overloaded function that takes a single PCB as input
+std::string print_PCB(PCB _PCB);
+
+std::string print_exec_header();
+std::string print_exec_status(unsigned int current_time, int PID, states old_state, states new_state);
+std::string print_exec_footer();
+
+//Parse one row of the execution table back into its transition; false for borders and the header
+bool parse_exec_status(const std::string &line, unsigned int &time, int &PID, states &old_state, states &new_state);
+
+//Synchronize the process in the process queue
+void sync_queue(std::vector<PCB> &process_queue, PCB _process);
+
+//Writes a string to a file
+void write_output(std::string execution, const char* filename);
+void report_output(bool written, const char* filename);
+
+//-------------------------------------------METRICS FOR THE SIMULATOR-----------------------------------
+
+process_metrics init_metrics(const PCB &process);
+
+//Charge the time since the last transition to the state being left, then enter new_state
+void track_transition(process_metrics &metrics, unsigned int current_time, states new_state);
+
+//Table of per-process metrics followed by the averages over all processes.
+//CPU share is the fraction of the process's lifetime (arrival to exit) it spent running.
+std::string print_metrics(const std::vector<process_metrics> &metrics);
+
+//Rebuild the metrics of a run from its execution table, for schedulers that only produce the trace
+std::vector<process_metrics> metrics_from_trace(const std::string &execution, const std::vector<PCB> &processes);
+
 //--------------------------------------------FUNCTIONS FOR THE "OS"-------------------------------------
 
-//Assign memory partition to program
-bool assign_memory(PCB &program) {
-    int size_to_fit = program.size;
-    int available_size = 0;
+//Memory model used by assign_memory/free_memory, selected with --memory=<model>
+enum memory_models {
+    FIXED_PARTITIONS,   // the six-entry memory_paritions[] table
+    FIRST_FIT,          // variable-size partitions, lowest address that fits
+    BEST_FIT,           // variable-size partitions, smallest hole that fits
+    NEXT_FIT,           // variable-size partitions, first fit from where the last search stopped
+    BUDDY,              // power-of-two buddy allocator
+    PAGED               // demand paging, a process's size is its number of pages
+};
+
+//Victim selection when every frame of the paged model is in use
+enum replacement_policies {
+    FIFO_REPLACEMENT,
+    LRU_REPLACEMENT,
+    CLOCK_REPLACEMENT
+};
+
+//One point of the memory utilization log, taken after every allocation and release
+struct memory_sample {
+    unsigned int    time;
+    unsigned int    requested;      // sum of the sizes of the resident processes
+    unsigned int    allocated;      // sum of the partitions/blocks handed out for them
+    unsigned int    free;
+    unsigned int    largest_free;
+};
+
+//Free holes of the variable-size models, as a treap keyed by address where every node also
+//knows the largest hole in its subtree, so the lowest-address hole that fits is found in O(log n)
+class free_block_tree {
+public:
+    void insert(unsigned int address, unsigned int size) {
+        int n = new_node(address, size);
+        int left, right;
+        split(root, address, left, right);
+        root = merge(merge(left, n), right);
+    }
+
+    void erase(unsigned int address) {
+        int left, middle, right;
+        split(root, address, left, middle);
+        split(middle, address + 1, middle, right);
+        if (middle != -1) free_nodes.push_back(middle);
+        root = merge(left, right);
+    }
+
+    //Lowest address >= from of a hole holding at least size, -1 if there is none
+    long find(unsigned int from, unsigned int size) const {
+        return find(root, from, size);
+    }
+
+    unsigned int largest() const { return root == -1 ? 0 : nodes[root].largest; }
 
-    for(int i = 5; i >= 0; i--) {
-        available_size = memory_paritions[i].size;
+private:
+    struct node {
+        unsigned int    address;
+        unsigned int    size;
+        unsigned int    largest;    // largest hole in this subtree
+        uint32_t        priority;
+        int             left;
+        int             right;
+    };
 
-        if(size_to_fit <= available_size && memory_paritions[i].occupied == -1) {
-            memory_paritions[i].occupied = program.PID;
-            program.partition_number = memory_paritions[i].partition_number;
-            return true;
+    int new_node(unsigned int address, unsigned int size) {
+        seed ^= seed << 13; seed ^= seed >> 17; seed ^= seed << 5;  // xorshift32
+        node n = {address, size, size, seed, -1, -1};
+        if (!free_nodes.empty()) {
+            int i = free_nodes.back();
+            free_nodes.pop_back();
+            nodes[i] = n;
+            return i;
         }
+        nodes.push_back(n);
+        return nodes.size() - 1;
     }
 
-    return false;
-}
+    void pull(int n) {
+        nodes[n].largest = nodes[n].size;
+        if (nodes[n].left != -1) nodes[n].largest = std::max(nodes[n].largest, nodes[nodes[n].left].largest);
+        if (nodes[n].right != -1) nodes[n].largest = std::max(nodes[n].largest, nodes[nodes[n].right].largest);
+    }
 
-//Free a memory partition
-bool free_memory(PCB &program){
-    for(int i = 5; i >= 0; i--) {
-        if(program.PID == memory_paritions[i].occupied) {
-            memory_paritions[i].occupied = -1;
-            program.partition_number = -1;
-            return true;
+    //left gets the addresses below address, right the rest
+    void split(int n, unsigned int address, int &left, int &right) {
+        if (n == -1) {
+            left = right = -1;
+        } else if (nodes[n].address < address) {
+            split(nodes[n].right, address, nodes[n].right, right);
+            left = n;
+            pull(n);
+        } else {
+            split(nodes[n].left, address, left, nodes[n].left);
+            right = n;
+            pull(n);
         }
     }
-    return false;
-}
 
-//Convert a list of strings into a PCB
-PCB add_process(std::vector<std::string> tokens) {
-    PCB process;
-    process.PID = std::stoi(tokens[0]);
-    process.size = std::stoi(tokens[1]);
-    process.arrival_time = std::stoi(tokens[2]);
-    process.processing_time = std::stoi(tokens[3]);
-    process.remaining_time = std::stoi(tokens[3]);
-    process.io_freq = std::stoi(tokens[4]);
-    process.io_duration = std::stoi(tokens[5]);
-    process.start_time = -1;
-    process.partition_number = -1;
-    process.state = NOT_ASSIGNED;
-
-    return process;
-}
+    int merge(int left, int right) {
+        if (left == -1) return right;
+        if (right == -1) return left;
+        if (nodes[left].priority > nodes[right].priority) {
+            nodes[left].right = merge(nodes[left].right, right);
+            pull(left);
+            return left;
+        }
+        nodes[right].left = merge(left, nodes[right].left);
+        pull(right);
+        return right;
+    }
 
-//Returns true if all processes in the queue have terminated
-bool all_process_terminated(std::vector<PCB> processes) {
+    long find(int n, unsigned int from, unsigned int size) const {
+        if (n == -1 || nodes[n].largest < size) return -1;
+        if (nodes[n].address >= from) {
+            long in_left = find(nodes[n].left, from, size);
+            if (in_left != -1) return in_left;
+            if (nodes[n].size >= size) return nodes[n].address;
+        }
+        return find(nodes[n].right, from, size);
+    }
+
+    std::vector<node> nodes;
+    std::vector<int> free_nodes;
+    int root = -1;
+    uint32_t seed = 2463534242u;
+};
+
+//State of the variable-size and buddy models
+struct dynamic_memory {
+    std::map<unsigned int, unsigned int>                holes;          // address -> size, for coalescing
+    free_block_tree                                     holes_by_address;
+    std::set<std::pair<unsigned int, unsigned int>>     holes_by_size;  // (size, address), for best-fit
+    unsigned int                                        next_fit_rover = 0;
+    std::vector<std::set<unsigned int>>                 buddy_free;     // order -> free block addresses
+    std::unordered_map<int, std::pair<unsigned int, unsigned int>> blocks; // PID -> (address, size)
+    unsigned int                                        free = 0;
+};
+
+//State of the paged model: frames, per-process page tables, a TLB tagged with the PID (so it is
+//not flushed on a context switch) and the bookkeeping of each replacement policy
+struct paged_memory {
+    std::vector<std::pair<int, unsigned int>>   frame_owner;    // frame -> (PID, page), PID -1 if free
+    std::vector<unsigned int>                   free_frames;
+    std::unordered_map<int, std::vector<int>>   page_tables;    // PID -> page -> frame, -1 if not resident
+
+    ring_queue<std::pair<unsigned int, unsigned long>> fifo;   // (frame, load stamp) in load order
+    std::vector<unsigned long>                  load_stamp;     // frame -> stamp of its current page
+    unsigned long                               next_stamp = 0;
+    std::list<unsigned int>                     lru;            // frames, most recently used first
+    std::vector<std::list<unsigned int>::iterator> lru_position; // frame -> its node in lru
+    std::vector<bool>                           referenced;     // CLOCK reference bits
+    std::vector<bool>                           pinned;         // loaded but not yet used by its process
+    unsigned int                                clock_hand = 0;
+
+    std::list<uint64_t>                         tlb;            // (PID, page) keys, most recent first
+    std::unordered_map<uint64_t, std::list<uint64_t>::iterator> tlb_index;
+
+    unsigned long   references = 0;
+    unsigned long   tlb_hits = 0;
+    unsigned long   page_faults = 0;
+    unsigned long   evictions = 0;
+};
 
-    for(auto process : processes) {
-        if(process.state != TERMINATED) {
-            return false;
+//------------------------------------------LATENCY HISTOGRAMS-----------------------------------------
+
+const unsigned int LATENCY_SUB_BITS = 7;
+const unsigned int LATENCY_SUB_BUCKETS = 1 << LATENCY_SUB_BITS;
+const size_t LATENCY_BUCKETS = LATENCY_SUB_BUCKETS * (32 - LATENCY_SUB_BITS + 1);
+
+//Log-linear (HDR style) histogram of latencies in ms: values below 2 * LATENCY_SUB_BUCKETS have a bucket each,
+//and every power of two above is split into LATENCY_SUB_BUCKETS buckets, so a bucket is narrower than 1/128 of
+//its values. Memory is bounded by LATENCY_BUCKETS counts however many values are recorded, and histograms of
+//different runs merge by adding counts. A percentile is the highest value of its bucket, capped by the exact maximum.
+class latency_histogram {
+public:
+    void record(uint32_t value, uint64_t count = 1) {
+        size_t i = bucket(value);
+        if (i >= counts.size()) counts.resize(i + 1, 0);
+        counts[i] += count;
+        total += count;
+        largest = std::max(largest, value);
+    }
+
+    void merge(const latency_histogram &other) {
+        if (other.counts.size() > counts.size()) counts.resize(other.counts.size(), 0);
+        for (size_t i = 0; i < other.counts.size(); i++) counts[i] += other.counts[i];
+        total += other.total;
+        largest = std::max(largest, other.largest);
+    }
+
+    //Take away the values of other, an earlier state of this histogram; the maximum becomes the bucket's bound
+    void subtract(const latency_histogram &other) {
+        for (size_t i = 0; i < other.counts.size(); i++) counts[i] -= other.counts[i];
+        total -= other.total;
+        while (!counts.empty() && counts.back() == 0) counts.pop_back();
+        largest = counts.empty() ? 0 : std::min(largest, highest(counts.size() - 1));
+    }
+
+    uint64_t count() const { return total; }
+
+    //Smallest bucket value with at least percentile % of the values at or below it; 0 when empty
+    uint32_t value_at(double percentile) const {
+        uint64_t rank = std::max<uint64_t>(1, (uint64_t)std::ceil(percentile / 100.0 * total));
+        uint64_t seen = 0;
+        for (size_t i = 0; i < counts.size(); i++) {
+            seen += counts[i];
+            if (seen >= rank) return std::min(highest(i), largest);
         }
+        return 0;
     }
+    uint32_t max() const { return largest; }
 
-    return true;
-}
+    //"<max> <buckets used> (<bucket> <count>)..." on one line, for merging histograms of separate runs
+    void write(std::ostream &out) const {
+        out << largest << " " << std::count_if(counts.begin(), counts.end(), [](uint64_t c){ return c > 0; });
+        for (size_t i = 0; i < counts.size(); i++) if (counts[i] > 0) out << " " << i << " " << counts[i];
+        out << "\n";
+    }
+    bool read(std::istream &in) {
+        *this = latency_histogram();
+        size_t used, i;
+        uint64_t count;
+        if (!(in >> largest >> used)) return false;
+        for (; used > 0; used--) {
+            if (!(in >> i >> count) || i >= LATENCY_BUCKETS) return false;
+            if (i >= counts.size()) counts.resize(i + 1, 0);
+            counts[i] += count;
+            total += count;
+        }
+        return true;
+    }
+
+    template <typename Archive>
+    void serialize(Archive &ar) {
+        archive(ar, counts);
+        archive(ar, total);
+        archive(ar, largest);
+    }
+
+private:
+    static size_t bucket(uint32_t value) {
+        if (value < 2 * LATENCY_SUB_BUCKETS) return value;
+        unsigned int shift = 31 - __builtin_clz(value) - LATENCY_SUB_BITS;
+        return LATENCY_SUB_BUCKETS * shift + (value >> shift);
+    }
+    static uint32_t highest(size_t i) {
+        if (i < 2 * LATENCY_SUB_BUCKETS) return i;
+        unsigned int shift = i / LATENCY_SUB_BUCKETS - 1;
+        uint64_t low = (uint64_t)(i - LATENCY_SUB_BUCKETS * shift) << shift;
+        return low + (1ull << shift) - 1;
+    }
+
+    std::vector<uint64_t>   counts;     // grows up to LATENCY_BUCKETS, as far as the largest value needs
+    uint64_t                total = 0;
+    uint32_t                largest = 0;
+};
+
+//The latency distributions of a run, or of several merged
+struct latency_report {
+    latency_histogram   waiting;        // time READY
+    latency_histogram   response;       // arrival to first READY -> RUNNING
+    latency_histogram   turnaround;
+    latency_histogram   io_queueing;    // per I/O request, time waiting for a device slot
+
+    void merge(const latency_report &other) {
+        waiting.merge(other.waiting);
+        response.merge(other.response);
+        turnaround.merge(other.turnaround);
+        io_queueing.merge(other.io_queueing);
+    }
+    void write(std::ostream &out) const {
+        waiting.write(out);
+        response.write(out);
+        turnaround.write(out);
+        io_queueing.write(out);
+    }
+    bool read(std::istream &in) {
+        return waiting.read(in) && response.read(in) && turnaround.read(in) && io_queueing.read(in);
+    }
+};
+
+//Waiting, response and turnaround of every terminated process
+latency_report latency_from_metrics(const std::vector<process_metrics> &metrics);
+
+//Table of p50/p90/p99/p99.9/max, one row per (label, histogram); rows with no values are left out
+std::string print_percentiles(const std::string &title, const std::vector<std::pair<std::string, const latency_histogram*>> &rows);
+std::string print_latency_report(const latency_report &report);
+
+//---------------------------------------------I/O DEVICES---------------------------------------------
+
+const unsigned int IO_TRACKS = 200;         // elevator positions
+
+//One I/O device (disk, network, ...): a service queue in front of `slots` requests served in parallel
+struct io_device {
+    std::string     name;
+    unsigned int    slots;              // concurrency limit
+    bool            elevator;           // SCAN order by track instead of FIFO
+
+    // requests waiting for a slot, keyed by (track, sequence) for the elevator and (sequence) for FIFO
+    std::map<std::pair<unsigned int, unsigned long>, std::pair<size_t, unsigned int>> queue;  // -> (tag, duration)
+    std::unordered_map<size_t, unsigned int> issued;     // tag -> time the request was submitted
+    unsigned int    in_service;
+    unsigned int    head;               // elevator position
+    bool            upward;
+
+    // statistics
+    unsigned long   requests;
+    uint64_t        busy_time;          // slot-ms spent serving
+    uint64_t        queueing_delay;     // ms requests spent waiting for a slot
+    latency_histogram queueing_delays;  // the same, per request (0 for one that got a slot at once)
+    uint64_t        depth_area;         // integral of the queue depth over time
+    unsigned int    max_depth;
+    unsigned int    window_max_depth;   // since the last what-if snapshot
+    unsigned int    last_change;
+};
+
+//Track an I/O request goes to: deterministic in (PID, request number), like referenced_page
+unsigned int io_track(int PID, unsigned long request);
+
+//Event-driven I/O completion: a min-heap of (completion time, start sequence) so each tick only pops the
+//I/Os finishing now, in the order they started. Requests for a busy device wait in its queue and are started
+//when a slot frees up; page faults and processes without a configured device (device < 0) never queue.
+class io_scheduler {
+public:
+    static constexpr unsigned int QUEUED = UINT32_MAX;
+
+    //devices and horizon belong to the Simulator whose scheduler this is
+    io_scheduler(std::vector<io_device> &devices, unsigned int &horizon) : io_devices(&devices), io_horizon(&horizon) {}
+
+    //Submit an I/O of `duration` ms for tag; returns its completion time, or QUEUED if it waits for a slot
+    unsigned int submit(unsigned int now, int device, unsigned int duration, size_t tag, int PID) {
+        if (device < 0 || (size_t)device >= io_devices->size()) return start(now, -1, duration, tag);
+        io_device &d = (*io_devices)[device];
+        d.requests++;
+        if (d.in_service < d.slots) {
+            d.queueing_delays.record(0);
+            return start(now, device, duration, tag);
+        }
+        advance(d, now);
+        unsigned int track = d.elevator ? io_track(PID, d.requests) : 0;
+        d.queue[{track, sequence++}] = {tag, duration};
+        d.issued[tag] = now;
+        d.max_depth = std::max<unsigned int>(d.max_depth, d.queue.size());
+        d.window_max_depth = std::max<unsigned int>(d.window_max_depth, d.queue.size());
+        return QUEUED;
+    }
+
+    bool empty() const {
+        return events.empty();
+    }
+
+    //In-flight and queued I/O of every device. A digest replaces the start sequences by their rank, since
+    //only their order matters for what happens next.
+    template <typename Archive>
+    void serialize(Archive &ar) {
+        std::vector<io_event> in_flight;
+        for (auto copy = events; !copy.empty(); copy.pop()) in_flight.push_back(copy.top());
+
+        std::vector<unsigned long> order;
+        if (ar.digest()) {
+            for (auto &event : in_flight) order.push_back(std::get<1>(event));
+            for (auto &d : *io_devices) for (auto &request : d.queue) order.push_back(request.first.second);
+            std::sort(order.begin(), order.end());
+        }
+        auto rank = [&](unsigned long s)->unsigned long{
+            return std::lower_bound(order.begin(), order.end(), s) - order.begin();
+        };
+        if (ar.digest()) for (auto &event : in_flight) std::get<1>(event) = rank(std::get<1>(event));
+
+        archive(ar, in_flight);
+        archive_history(ar, sequence);
+        for (auto &d : *io_devices) {
+            if (ar.digest()) {
+                std::map<std::pair<unsigned int, unsigned long>, std::pair<size_t, unsigned int>> queue;
+                for (auto &request : d.queue) queue[{request.first.first, rank(request.first.second)}] = request.second;
+                archive(ar, queue);
+            } else {
+                archive(ar, d.queue);
+            }
+            archive_history(ar, d.issued);
+            archive(ar, d.in_service);
+            archive(ar, d.head);
+            archive(ar, d.upward);
+        }
+
+        if (ar.loading()) {
+            events = decltype(events)();
+            for (auto &event : in_flight) events.push(event);
+        }
+    }
+
+    //Pop the next I/O finishing at now, starting the next queued request of its device; false when none is left
+    bool next_completion(unsigned int now, size_t &tag) {
+        *io_horizon = std::max(*io_horizon, now);
+        if (events.empty() || std::get<0>(events.top()) != now) return false;
+        tag = std::get<2>(events.top());
+        int device = std::get<3>(events.top());
+        events.pop();
+        if (device >= 0) {
+            io_device &d = (*io_devices)[device];
+            d.in_service--;
+            if (!d.queue.empty()) {
+                advance(d, now);
+                auto next = pick(d);
+                auto request = next->second;
+                d.queueing_delay += now - d.issued[request.first];
+                d.queueing_delays.record(now - d.issued[request.first]);
+                d.issued.erase(request.first);
+                d.queue.erase(next);
+                start(now, device, request.second, request.first);
+            }
+        }
+        return true;
+    }
+
+private:
+    typedef std::tuple<unsigned int, unsigned long, size_t, int> io_event;    // (completion, sequence, tag, device)
+    std::vector<io_device> *io_devices;
+    unsigned int *io_horizon;           // last time the I/O subsystem was polled, for utilization
+    std::priority_queue<io_event, std::vector<io_event>, std::greater<io_event>> events;
+    unsigned long sequence = 0;
+
+    unsigned int start(unsigned int now, int device, unsigned int duration, size_t tag) {
+        if (device >= 0) {
+            (*io_devices)[device].in_service++;
+            (*io_devices)[device].busy_time += duration;
+        }
+        events.push({now + duration, sequence++, tag, device});
+        return now + duration;
+    }
+
+    //Accumulate the time-weighted queue depth up to now
+    void advance(io_device &d, unsigned int now) {
+        d.depth_area += (uint64_t)d.queue.size() * (now - d.last_change);
+        d.last_change = now;
+    }
+
+    //FIFO: oldest request. Elevator (LOOK): nearest track in the current direction, reversing at the last request.
+    std::map<std::pair<unsigned int, unsigned long>, std::pair<size_t, unsigned int>>::iterator pick(io_device &d) {
+        if (!d.elevator) return d.queue.begin();   // every FIFO request is on track 0
+        auto next = d.queue.lower_bound({d.head, 0});
+        if (d.upward && next == d.queue.end()) d.upward = false;
+        if (!d.upward) {
+            next = d.queue.upper_bound({d.head, ULONG_MAX});
+            if (next == d.queue.begin()) {
+                d.upward = true;
+                next = d.queue.lower_bound({d.head, 0});
+            } else {
+                --next;
+            }
+        }
+        d.head = next->first.first;
+        return next;
+    }
+};
+
+//-------------------------------------MEDIUM-TERM SCHEDULER (SWAPPING)----------------------------------
+
+//A process image being written to or read from the backing store
+struct swap_transfer {
+    int             PID;
+    unsigned int    done_time;
+    int             target;     // swap-out only: pending PID that gets the freed memory
+};
+
+struct swap_space {
+    std::vector<swap_transfer>  swapping_out;
+    std::vector<swap_transfer>  swapping_in;
+    std::vector<int>            suspended;      // SUSPENDED_READY PIDs on the backing store, FIFO
+};
+
+//WAITING processes of the policies that swap (EP, RR, EP_RR) with their I/O completion time, keyed by the time they
+//started waiting. Only one process leaves the CPU per tick, so the key is unique: it doubles as the io_scheduler
+//tag, and the medium-term scheduler still sees the waiters in the order they came.
+typedef std::map<unsigned int, std::pair<PCB, unsigned int>> wait_list;
+
+void set_state(std::vector<PCB> &list_process, int PID, states state);
+
+void archive(state_archive &ar, swap_space &swap);
+void archive(state_archive &ar, dynamic_memory &memory);
+void archive(state_archive &ar, paged_memory &memory);
+
+//-------------------------------------------WHAT-IF RE-SIMULATION------------------------------------------
+
+//--what-if=<PID>:<field>=<value>[:<field>=<value>...], one process of the workload changed
+struct what_if_change {
+    bool                                        active = false;
+    int                                         PID = -1;
+    std::vector<std::pair<std::string, long>>   fields;
+};
+const std::vector<std::string> WHAT_IF_FIELDS = {"size", "arrival", "burst", "io-freq", "io-duration", "nice", "deadline", "tickets", "device"};
+
+void apply_what_if(const what_if_change &change, PCB &process);
+
+//Statistics left out of a digest, captured with every snapshot so a what-if that re-converges can add what the
+//original run accumulated after that point
+struct device_counters {
+    uint64_t        busy_time;
+    uint64_t        queueing_delay;
+    latency_histogram queueing_delays;
+    uint64_t        depth_area;         // integrated up to the snapshot time
+    unsigned int    window_max_depth;   // since the previous snapshot
+};
+
+struct os_counters {
+    unsigned long                   references, tlb_hits, page_faults, evictions;
+    std::vector<device_counters>    devices;
+};
+
+struct what_if_snapshot {
+    unsigned int    time;
+    std::string     state;              // SAVE archive, without the memory log
+    std::string     digest;
+    size_t          trace_length;
+    size_t          log_length;
+    os_counters     counters;
+};
+
+//Pass 1 runs the original workload taking a snapshot every checkpoint_interval ms; pass 2 restores the latest
+//snapshot the change cannot have affected yet and compares digests at every later snapshot time
+struct what_if_run {
+    bool                            recording = false;
+    bool                            replaying = false;
+    unsigned int                    affected_time = 0;
+    std::vector<what_if_snapshot>   snapshots;
+    std::string                     trace;          // of the original run
+    std::vector<memory_sample>      log;
+    os_counters                     counters;       // at the end of the original run
+    std::vector<io_device>          devices;
+    unsigned int                    horizon = 0;
+    unsigned int                    restored_from = 0;
+    unsigned int                    converged_at = 0;   // 0 if the changed run never re-converged
+};
+
+//-------------------------------------------------LOAD SAMPLES------------------------------------------------
+
+//The series a load sample reads off the simulator
+enum load_series {
+    READY_QUEUE,
+    WAIT_QUEUE,
+    PENDING_ADMISSION,      // arrived, still NEW or NOT_ASSIGNED
+    OCCUPIED_PARTITIONS,    // partitions, blocks or frames, by memory model
+    OCCUPIED_MEMORY,        // MB allocated, frames for the paged model
+    CPU_BUSY,               // 1 while a process is RUNNING, so its average is the utilization
+    LOAD_SERIES
+};
+const char* const LOAD_SERIES_NAMES[LOAD_SERIES] = {"ready", "waiting", "pending", "partitions", "memory", "cpu_busy"};
+
+const size_t DEFAULT_SAMPLE_ROWS = 1000;
+
+//Load of a run sampled every interval ms of simulated time and downsampled to at most max_rows rows of min/max/sum:
+//once the rows are full every two neighbours are merged and a row covers twice as many samples, so the output stays
+//the same size however long the run. Queue lengths come from the transitions the simulator emits.
+class load_sampler {
+public:
+    void reset(unsigned int sample_interval, size_t rows_kept, const std::vector<PCB> &workload) {
+        interval = sample_interval;
+        max_rows = std::max<size_t>(2, rows_kept & ~(size_t)1);
+        width = 1;
+        next_sample = 0;
+        rows.clear();
+        std::fill(std::begin(in_state), std::end(in_state), 0);
+        admitted = 0;
+        arrived = 0;
+        arrivals.clear();
+        for (auto &p : workload) arrivals.push_back(p.arrival_time);
+        std::sort(arrivals.begin(), arrivals.end());
+    }
+    bool enabled() const { return interval > 0; }
+    bool due(unsigned int now) const { return now >= next_sample; }
+
+    //A delivered process, arriving after every sample taken so far
+    void arrival(unsigned int time) {
+        arrivals.insert(std::upper_bound(arrivals.begin(), arrivals.end(), time), time);
+    }
+    void transition(states old_state, states new_state) {
+        in_state[old_state]--;
+        in_state[new_state]++;
+        if (old_state == NEW || old_state == NOT_ASSIGNED) admitted++;
+    }
+
+    //Take the sample of now, given the memory series the sampler cannot see
+    void sample(unsigned int now, unsigned int partitions, unsigned int memory) {
+        while (arrived < arrivals.size() && arrivals[arrived] <= now) arrived++;
+        unsigned int values[LOAD_SERIES] = {(unsigned int)in_state[READY], (unsigned int)in_state[WAITING],
+                                            (unsigned int)(arrived - admitted), partitions, memory, in_state[RUNNING] > 0};
+        if (rows.empty() || rows.back().samples == width) {
+            if (rows.size() == max_rows) downsample();
+            if (rows.empty() || rows.back().samples == width) rows.push_back(sample_row{now, 0, {}, {}, {}});
+        }
+        sample_row &row = rows.back();
+        for (int s = 0; s < LOAD_SERIES; s++) {
+            row.min[s] = row.samples == 0 ? values[s] : std::min(row.min[s], values[s]);
+            row.max[s] = std::max(row.max[s], values[s]);
+            row.sum[s] += values[s];
+        }
+        row.samples++;
+        next_sample = now + interval;
+    }
+
+    //Columnar: a header line, then one line per column, the row start times and min/max/avg of every series
+    std::string print() const {
+        std::ostringstream out;
+        out << "# " << rows.size() << " rows of up to " << width << " sample(s), one sample every " << interval << " ms\n";
+        out << "time";
+        for (auto &row : rows) out << " " << row.start;
+        out << "\n" << std::fixed << std::setprecision(2);
+        for (int s = 0; s < LOAD_SERIES; s++) {
+            out << LOAD_SERIES_NAMES[s] << "_min";
+            for (auto &row : rows) out << " " << row.min[s];
+            out << "\n" << LOAD_SERIES_NAMES[s] << "_max";
+            for (auto &row : rows) out << " " << row.max[s];
+            out << "\n" << LOAD_SERIES_NAMES[s] << "_avg";
+            for (auto &row : rows) out << " " << (double)row.sum[s] / row.samples;
+            out << "\n";
+        }
+        return out.str();
+    }
+
+    template <typename Archive>
+    void serialize(Archive &ar) {
+        archive(ar, width);
+        archive(ar, next_sample);
+        archive(ar, rows);
+        archive(ar, in_state);
+        archive(ar, admitted);
+        archive(ar, arrived);
+    }
+
+private:
+    struct sample_row {
+        unsigned int    start;
+        unsigned int    samples;
+        unsigned int    min[LOAD_SERIES];
+        unsigned int    max[LOAD_SERIES];
+        uint64_t        sum[LOAD_SERIES];
+    };
+
+    void downsample() {
+        size_t kept = 0;
+        for (size_t i = 0; i < rows.size(); i += 2, kept++) {
+            sample_row row = rows[i];
+            if (i + 1 < rows.size()) {
+                const sample_row &next = rows[i + 1];
+                for (int s = 0; s < LOAD_SERIES; s++) {
+                    row.min[s] = std::min(row.min[s], next.min[s]);
+                    row.max[s] = std::max(row.max[s], next.max[s]);
+                    row.sum[s] += next.sum[s];
+                }
+                row.samples += next.samples;
+            }
+            rows[kept] = row;
+        }
+        rows.resize(kept);
+        width *= 2;
+    }
+
+    unsigned int                interval = 0;       // 0 = not sampling
+    size_t                      max_rows = DEFAULT_SAMPLE_ROWS;
+    unsigned int                width = 1;          // samples per full row
+    unsigned int                next_sample = 0;
+    std::vector<sample_row>     rows;
+    int                         in_state[SUSPENDED_WAITING + 1] = {};   // processes per state, by the transitions
+    size_t                      admitted = 0;
+    size_t                      arrived = 0;
+    std::vector<unsigned int>   arrivals;           // sorted
+};
+
+//-------------------------------------------------TRACE STORE-------------------------------------------------
+//A run's process table over time, for point-in-time queries: a full snapshot of the live processes every
+//interval ms of simulated time, the state and memory events in between, and at the end an index of snapshot
+//time -> file offset with the static fields of every process. A query reads one snapshot and replays at most one
+//interval of events, however far into the run it looks.
+//
+//File: magic, then the records (a snapshot is 'S' time count {process}, an event 'E' time index state or 'M'
+//time index partition), then the footer (interval, end, workload entries, snapshot (time, offset) pairs), its
+//offset and the magic again.
+
+const std::string TRACE_STORE_MAGIC = "SIMTRIX1";
+const unsigned int DEFAULT_INDEX_INTERVAL = 10000;
+const uint32_t NEVER = UINT32_MAX;
+
+//The fields of a process that do not change, and when it entered and left the process table
+struct stored_workload_entry {
+    int32_t     PID;
+    uint32_t    size;
+    uint32_t    arrival_time;
+    uint32_t    processing_time;
+    uint32_t    admitted;           // first transition, NEVER if it never got one
+    uint32_t    finished;           // TERMINATED, NEVER if it did not
+};
+
+//A process in the table: admitted, not terminated
+struct stored_process {
+    uint32_t    index;              // in the workload
+    uint32_t    state;              // a states, 32 bits wide so the record has no padding
+    int32_t     partition;
+    int32_t     start_time;         // first RUNNING, -1 before
+    uint32_t    cpu_used;           // ms RUNNING up to since
+    uint32_t    since;              // last transition
+};
+
+class trace_store_writer {
+public:
+    //Prints an error and leaves ok() false if path cannot be created
+    trace_store_writer(const std::string &path, unsigned int interval, const std::vector<PCB> &workload);
+    bool ok() const { return file.good(); }
+
+    void add_process(const PCB &process);       // delivered after the start
+    void transition(unsigned int time, int PID, states new_state);
+    void partition(unsigned int time, int PID, int partition_number);
+    //Write the index; false (after printing an error) if the file could not be written
+    bool finish();
+
+private:
+    void snapshot_before(unsigned int time);
+    void record(char kind, unsigned int time, uint32_t index, int32_t value);
+    void flush();
+
+    std::string                         path;
+    std::ofstream                       file;
+    unsigned int                        interval;
+    unsigned int                        next_snapshot = 0;
+    unsigned int                        end = 0;
+    state_archive                       buffer{state_archive::SAVE};
+    uint64_t                            flushed = 0;    // bytes already in the file
+    std::vector<stored_workload_entry>  processes;
+    std::unordered_map<int, uint32_t>   index_of;       // PID -> index in processes
+    std::vector<stored_process>         table;          // by index
+    std::vector<uint32_t>               live;           // indices in the table, any order
+    std::vector<int64_t>                live_position;  // index -> position in live, -1 if not live
+    std::vector<std::pair<uint32_t, uint64_t>> snapshots;   // (time, offset)
+};
+
+class trace_store_reader {
+public:
+    //Reads the index of the store at path; false (after printing an error) if it is not a complete store
+    bool open(const std::string &path);
+    unsigned int end_time() const { return end; }
 
-//Terminates a given process
-void terminate_process(PCB &running, std::vector<PCB> &job_queue) {
-    running.remaining_time = 0;
-    running.state = TERMINATED;
-    free_memory(running);
-    sync_queue(job_queue, running);
+    //The process table at time (after every event at that time) sorted by PID: the live processes and the ones
+    //that arrived and still wait for admission (NOT_ASSIGNED). Remaining time is the processing time less the
+    //time RUNNING so far.
+    std::vector<PCB> table_at(unsigned int time, size_t &terminated) const;
+
+private:
+    std::string                         path;
+    unsigned int                        interval = 0;
+    unsigned int                        end = 0;
+    uint64_t                            footer = 0;     // offset, where the last segment ends
+    std::vector<stored_workload_entry>  processes;
+    std::vector<std::pair<uint32_t, uint64_t>> snapshots;
+};
+
+//------------------------------------------------SIMULATOR------------------------------------------------
+
+//Everything selected on the command line that is not specific to a scheduling policy
+struct simulator_options {
+    memory_models           memory_model = FIXED_PARTITIONS;
+    unsigned int            memory_size = 100;      // MB for the dynamic models, same total as DEFAULT_PARTITIONS
+    unsigned int            frame_count = 64;
+    unsigned int            tlb_size = 16;
+    unsigned int            page_fault_time = 10;   // ms a faulting process spends WAITING for the page
+    replacement_policies    replacement_policy = LRU_REPLACEMENT;
+
+    bool                    swapping_enabled = false;   // medium-term scheduler, --swap
+    unsigned int            swap_out_time = 5;      // ms to write a process image to the backing store
+    unsigned int            swap_in_time = 5;       // ms to read it back
+
+    std::vector<io_device>  devices;                // --device=..., empty means every I/O starts at once
+
+    std::string             checkpoint_path;        // --checkpoint=<file>, empty = no checkpoints
+    unsigned int            checkpoint_interval = 10000;    // --checkpoint-interval=<ms> of simulated time
+    std::string             resume_path;            // --resume=<file>
+    std::string             run_signature;          // command line without the checkpoint options, must match on resume
+
+    what_if_change          what_if;
+
+    unsigned int            time_limit = 0;         // --time-limit=<ms> of simulated time, 0 = none
+    double                  wall_limit = 0;         // --wall-limit=<s> of real time, 0 = none
+
+    std::string             cache_path;             // --cache=<dir> of earlier results, empty = no cache
+    uint64_t                cache_size = 256ull << 20;  // --cache-size=<MB>, least recently used entries go first
+
+    std::string             trace_index_path;       // --trace-index=<file>, empty = no trace store
+    unsigned int            index_interval = DEFAULT_INDEX_INTERVAL;    // --index-interval=<ms> between snapshots
+
+    unsigned int            sample_interval = 0;    // --sample-interval=<ms> of simulated time, 0 = no load samples
+    size_t                  sample_rows = DEFAULT_SAMPLE_ROWS;  // --sample-rows=<n>, rows kept after downsampling
+};
+
+//Parse text, the value given to option, into value: a whole number from minimum to the largest T (for a floating
+//point T, any finite number from minimum). Anything else is an error naming the option; returns false after printing it.
+template <typename T>
+bool parse_number(const std::string &option, const std::string &text, T &value, long long minimum = 0) {
+    std::ostringstream expected;
+    try {
+        size_t used = 0;
+        if constexpr (std::is_floating_point<T>::value) {
+            double number = std::stod(text, &used);
+            if (used == text.size() && std::isfinite(number) && number >= minimum) {
+                value = number;
+                return true;
+            }
+        } else if (!text.empty() && text[0] == '-') {
+            long long number = std::stoll(text, &used);
+            if (used == text.size() && number >= minimum && number >= (long long)std::numeric_limits<T>::min()) {
+                value = (T)number;
+                return true;
+            }
+        } else if (!text.empty() && std::isdigit((unsigned char)text[0])) {     // stoull would wrap " -1"
+            unsigned long long number = std::stoull(text, &used);
+            if (used == text.size() && (minimum <= 0 || number >= (unsigned long long)minimum) &&
+                number <= (unsigned long long)std::numeric_limits<T>::max()) {
+                value = (T)number;
+                return true;
+            }
+        }
+    } catch (const std::exception &) {}     // not a number at all, or beyond long long
+    if constexpr (std::is_floating_point<T>::value) expected << "a number of at least " << minimum;
+    else expected << "a whole number from " << std::max<long long>(minimum, std::numeric_limits<T>::min()) << " to " << std::numeric_limits<T>::max();
+    std::cerr << "Error: " << option << " expects " << expected.str() << ", got \"" << text << "\"" << std::endl;
+    return false;
 }
 
+//Parse "<name>[:<slots>[:fifo|elevator]]" and append the device
+bool add_device(simulator_options &options, const std::string &spec);
+
+//Consume the memory options (--memory=fixed|first-fit|best-fit|next-fit|buddy|paged, --memory-size=<MB>,
+//for paging --frames=<n>, --tlb-size=<n>, --page-fault-time=<ms>, --replacement=fifo|lru|clock, and for
+//swapping --swap, --swap-out-time=<ms>, --swap-in-time=<ms>, I/O devices --device=<name>[:<slots>[:fifo|elevator]]
+//(repeatable, indexed in order), checkpoints (--checkpoint=<file>, --checkpoint-interval=<ms>, --resume=<file>),
+//what-if re-simulation (--what-if=<PID>:<field>=<value>[:...], snapshots every --checkpoint-interval ms),
+//the watchdog limits (--time-limit=<ms>, --wall-limit=<s>), the result cache (--cache=<dir>, --cache-size=<MB>),
+//the trace store (--trace-index=<file>, --index-interval=<ms>) and load sampling (--sample-interval=<ms>,
+//--sample-rows=<n>) from argv into options, leaving the positional arguments in place. Returns the new argc or
+//-1 on a bad option.
+int parse_simulator_options(int argc, char** argv, simulator_options &options);
+
+//Receives the transitions of a run as they happen. restart() means the trace so far was replaced (a load, a
+//resume or a what-if restore) and is followed by the events of the replacement; finish() ends the run.
+class trace_sink {
+public:
+    virtual ~trace_sink() = default;
+    virtual void transition(unsigned int time, int PID, states old_state, states new_state) = 0;
+    virtual void restart() {}
+    virtual void finish() {}
+};
+
+//One row of the execution table in binary form, as the simulator hands it to the formatter thread
+struct exec_event {
+    unsigned int    time;
+    int             PID;
+    uint8_t         old_state;
+    uint8_t         new_state;
+};
+
+//Gantt chart of a run at a fixed resolution: columns x rows cells, each with the time its processes spent RUNNING,
+//READY and WAITING. A column starts as 1 ms and a row as one process (in order of first appearance); whenever the
+//run outgrows the grid every two neighbouring columns (or rows) are merged, so memory, rendering time and output
+//size depend on the resolution, not on how long the run is or how many events it has.
+class gantt_grid {
+public:
+    enum shown_states {
+        SHOWN_RUNNING,
+        SHOWN_READY,
+        SHOWN_WAITING,
+        SHOWN_STATES
+    };
+
+    //Sizes are rounded up to even counts so neighbours pair up
+    gantt_grid(size_t columns, size_t rows)
+        : columns(std::max<size_t>(columns + 1, 2) & ~(size_t)1), rows(std::max<size_t>(rows + 1, 2) & ~(size_t)1),
+          cells(this->columns * this->rows) {}
+
+    void clear();
+    //Another process, the next row unless the rows are full
+    void add_process();
+    //Process (by order of appearance) spent [from, to) in state
+    void add(size_t process, unsigned int from, unsigned int to, shown_states state);
+
+    //RUNNING green, READY amber, WAITING blue, each cell in its dominant state and faded by how full it is
+    std::string svg(const std::vector<int> &PIDs, unsigned int end) const;
+    //'#' RUNNING, '=' READY, '.' WAITING, blank when none of them
+    std::string ascii(const std::vector<int> &PIDs, unsigned int end) const;
+
+private:
+    typedef std::array<uint64_t, SHOWN_STATES> cell;
+
+    void widen_columns();
+    void merge_rows();
+    //Dominant state of a cell, SHOWN_STATES if empty, and how much of the cell it fills in [0, 1]
+    shown_states dominant(const cell &c, double &fill) const;
+    std::string row_label(size_t row, const std::vector<int> &PIDs) const;
+
+    size_t              columns, rows;
+    uint64_t            scale = 1;          // ms per column
+    size_t              group = 1;          // processes per row
+    size_t              processes = 0;
+    std::vector<cell>   cells;              // row-major, rows x columns
+};
+
+//Builds Gantt charts from the transitions of a run: one at image resolution for the SVG, one for the ASCII chart.
+//A sink of a Simulator, or fed the rows of an execution table.
+class gantt_chart : public trace_sink {
+public:
+    gantt_chart(size_t image_columns, size_t image_rows, size_t text_columns, size_t text_rows)
+        : image(image_columns, image_rows), text(text_columns, text_rows) {}
+
+    void transition(unsigned int time, int PID, states old_state, states new_state) override;
+    void restart() override;
+    void finish() override;
+
+    std::string svg() const { return image.svg(PIDs, end); }
+    std::string ascii() const { return text.ascii(PIDs, end); }
+
+private:
+    struct process_track {
+        size_t          index;      // order of first appearance
+        states          state;
+        unsigned int    since;
+    };
+
+    void close(process_track &track, unsigned int time);
+
+    gantt_grid                                  image, text;
+    std::unordered_map<int, process_track>      tracks;
+    std::vector<int>                            PIDs;       // by order of first appearance
+    unsigned int                                end = 0;    // latest transition time seen
+};
+
+//One simulation: the "OS" (memory model, paging, swapping, I/O devices, checkpoints, watchdog), the clock and
+//the trace. A subclass per scheduling policy adds its queues and implements one tick. There is no global
+//state, so any number of Simulators can run side by side, one per thread.
+//Usage: load() a workload, then step(), run_until() or run(), and query the trace, metrics and reports.
+class Simulator {
+public:
+    explicit Simulator(const simulator_options &options);
+    virtual ~Simulator() = default;
+
+    //Load-time admission check: a process bigger than memory_capacity() would stay NOT_ASSIGNED forever, one
+    //mapped to a device that is not configured could never finish its I/O, and the policy may refuse others
+    //(process_schedulable). Prints every such process and returns false if there is any.
+    bool admission_feasible(const std::vector<PCB> &list_process) const;
+
+    //Start over with a new workload at time 0
+    void load(const std::vector<PCB> &workload);
+
+    //Simulate one ms; false once the run is over (every process terminated, the watchdog fired, a what-if run
+    //re-converged or a checkpoint could not be resumed)
+    bool step();
+    void run_until(unsigned int time);
+
+    //Add a process to the loaded run, as a cluster host does when the router places a job on it. It must arrive
+    //after now(). While arrivals are held open the run keeps going with nothing left to do instead of ending
+    //(or tripping the stall watchdog), since more processes may still be delivered.
+    void deliver(const PCB &process);
+    void hold_arrivals(bool open) { arrivals_open = open; }
+
+    //Stream a workload in input order: start_stream() begins an empty run held open for arrivals, stream()
+    //delivers the next process and simulates up to its arrival. A process arriving in the simulated past breaks
+    //the stream (stream() returns false from then on and the caller keeps the rest); finish_stream() then starts
+    //over with the whole workload, otherwise it just runs to the end.
+    void start_stream();
+    bool stream(const PCB &process);
+    void finish_stream(const std::vector<PCB> &workload);
+
+    //Run to the end. With --what-if the workload is run twice: once as given, taking snapshots, then with the
+    //change applied, re-simulating only from the latest snapshot before the changed process arrives and stopping
+    //as soon as the state re-converges with the original run.
+    void run();
+
+    //Not owned; must outlive the run or be detached
+    void attach_trace(trace_sink &sink);
+    void detach_trace(trace_sink &sink);
+
+    //Whether the execution table is also built in memory (the default). Checkpoints, what-if runs and the
+    //default run_metrics() need it; without it execution() stays empty and only the sinks see the run.
+    void keep_trace(bool keep) { trace_kept = keep || needs_trace(); }
+    bool needs_trace() const {
+        return !options.checkpoint_path.empty() || !options.resume_path.empty() || options.what_if.active ||
+               !options.cache_path.empty();
+    }
+
+    //Everything the outputs of running workload depend on: the engine version, the policy and its parameters,
+    //the options and the workload itself. Empty when the run cannot be cached (it checkpoints, resumes or writes
+    //a trace store).
+    std::string result_key(const std::vector<PCB> &workload) const;
+    const simulator_options &configuration() const { return options; }
+
+    unsigned int now() const { return current_time; }
+    size_t unfinished() const { return total_processes - terminated_count; }
+    bool finished() const { return done; }
+    bool failed() const { return error; }
+    bool stopped_by_watchdog() const { return watchdog_tripped; }
+    const std::vector<PCB> &processes() const { return list_process; }
+    const std::string &execution() const { return execution_status; }
+    bool has_devices() const { return !io_devices.empty(); }
+
+    //Per-process metrics of the last run: kept while the run goes by the policies that keep_metrics(), otherwise
+    //(and for a what-if run, which splices in part of the original trace) rebuilt from the trace
+    virtual std::vector<process_metrics> run_metrics() const;
+    std::string print_process_metrics() const { return print_metrics(run_metrics()); }
+    //Latency distributions of the last run, I/O queueing over all devices
+    latency_report latency() const;
+    std::string print_memory_log() const;
+    std::string print_device_stats() const;
+    std::string what_if_summary() const;
+    bool has_samples() const { return options.sample_interval > 0; }
+    std::string print_load_samples() const { return load_samples.print(); }
+
+protected:
+    //--- implemented by each policy ---
+    virtual void start() = 0;                               // reset the policy state for list_process
+    virtual void tick() = 0;                                // everything that happens in current_time
+    virtual bool stalled() const = 0;                       // no event can ever happen again
+    virtual void archive_state(state_archive &ar) = 0;      // everything tick() carries to the next tick
+    virtual std::string policy_signature() const = 0;       // the policy and its parameters, for result_key
+    virtual void process_added(size_t index) { (void)index; }  // list_process[index] was delivered after start()
+    virtual bool process_schedulable(const PCB &process) const { (void)process; return true; }  // else prints why
+    virtual bool admit(size_t index) { (void)index; return false; }  // list_process[index] got memory, now READY
+
+    //Append a transition to the trace and pass it to the sinks
+    void emit(unsigned int time, int PID, states old_state, states new_state);
+
+    //--- memory ---
+    bool assign_memory(PCB &program, unsigned int current_time = 0);
+    bool free_memory(PCB &program, unsigned int current_time = 0);
+    bool page_fault(const PCB &program, unsigned int current_time);
+    unsigned int largest_free_partition() const;
+    unsigned int allocated_size(const PCB &program) const;
+    void terminate_process(PCB &running, std::vector<PCB> &job_queue, unsigned int current_time = 0);
+
+    //--- swapping ---
+    void suspended_io_done(swap_space &swap, const PCB &process, unsigned int now);
+    void medium_term_scheduler(swap_space &swap, std::vector<PCB> &ready_queue, wait_list &wait_queue, unsigned int now);
+
+    //--- checkpoints and what-if ---
+    void archive_arrivals(state_archive &ar, std::vector<size_t> &arrivals, size_t &next_arrival);
+
+    //Put a delivered process into an arrival order (stable by arrival time) among the arrivals still to come
+    void add_arrival(std::vector<size_t> &arrivals, size_t next_arrival, size_t index) const;
+
+    //--- admission, for the policies that keep list_process indices ---
+    //Every process in arrival order, stable so that same-tick arrivals keep input order
+    void order_arrivals(std::vector<size_t> &arrivals, size_t &next_arrival) const;
+    //admit() the processes arriving now; the ones that do not fit wait in pending, in input order
+    void admit_arrivals(const std::vector<size_t> &arrivals, size_t &next_arrival, std::set<size_t> &pending);
+    //Once memory was freed, admit() pending processes in input order for as long as one can still fit
+    void retry_pending(std::set<size_t> &pending, bool &memory_freed);
+
+    //--- metrics kept while the run goes ---
+    //Called by start(): from then on transition() tracks every process in metrics and run_metrics() returns them
+    void keep_metrics();
+    //Emit a transition of list_process[index] and set its state (and its metrics, if kept)
+    void transition(unsigned int time, size_t index, states old_state, states new_state);
+
+    //True when an arrived process still waiting for memory would fit right now
+    bool admission_possible(unsigned int now) const;
+
+    const simulator_options     options;
+
+    std::vector<PCB>            list_process;       // the policy's process table, in input order
+    size_t                      total_processes = 0;
+    size_t                      terminated_count = 0;
+    unsigned int                current_time = 0;
+    std::string                 execution_status;
+
+    std::vector<io_device>      io_devices;
+    unsigned int                io_horizon = 0;     // last time the I/O subsystem was polled, for utilization
+
+    std::vector<process_metrics> metrics;           // see keep_metrics(); archived by the policy
+
+private:
+    void add_hole(unsigned int address, unsigned int size);
+    void remove_hole(unsigned int address);
+    void init_memory();
+    void init_devices();
+    unsigned int free_memory_total() const;
+    void log_memory(unsigned int current_time);
+    long allocate_block(PCB &program);
+    bool release_block(PCB &program);
+    void tlb_insert(uint64_t key);
+    void tlb_erase(uint64_t key);
+    long evict_frame();
+    void release_pages(const PCB &program);
+    unsigned int memory_capacity() const;
+
+    void archive_run(state_archive &ar);
+    void archive_os_state(state_archive &ar);
+    bool checkpoint_due(unsigned int now) const;
+    bool checkpoint_tick(unsigned int now);
+    void save_checkpoint();
+    bool load_checkpoint();
+    void restore_trace(const std::string &trace);
+    void sample_load(unsigned int now);
+    void forward_trace(const std::string &rows);
+
+    os_counters capture_counters(unsigned int now);
+    void what_if_record(unsigned int now);
+    void what_if_restore();
+    bool what_if_converged(unsigned int now);
+
+    //Progress watchdog, called once per tick. stalled means no event can ever happen again: the CPU is idle,
+    //the ready and wait queues are empty, nothing is left to arrive and no pending admission can succeed.
+    //Returns true (after printing a diagnostic) when the run has to stop; the caller keeps the partial trace.
+    bool watchdog_expired(unsigned int now, bool stalled, size_t unfinished);
+
+    std::vector<PCB>            workload;           // as loaded, for the metrics
+    std::vector<trace_sink*>    sinks;
+    bool                        trace_kept = true;
+    bool                        arrivals_open = false;      // see hold_arrivals()
+    bool                        streaming = false;          // see start_stream()
+    bool                        metrics_kept = false;       // see keep_metrics()
+    bool                        done = false;
+    bool                        error = false;
+
+    memory_partition            memory_paritions[6];
+    dynamic_memory              dynamic_partitions;
+    std::vector<memory_sample>  memory_log;
+    unsigned int                memory_requested = 0;
+    unsigned int                memory_allocated = 0;
+    paged_memory                paging;
+
+    bool                        resume_pending = false;     // set until the first tick has restored --resume
+    uint64_t                    trace_flushed = 0;          // bytes of the trace already in <checkpoint>.trace
+    what_if_run                 what_if_state;
+    load_sampler                load_samples;
+    std::unique_ptr<trace_store_writer> trace_store;    // --trace-index, from load() to the end of the run
+
+    bool                        watchdog_tripped = false;   // set when the watchdog stopped the run
+    std::chrono::steady_clock::time_point wall_start;
+};
+
+//Read an input file into processes; columns as in add_process
+bool read_workload(const std::string &file_name, std::vector<PCB> &processes);
+void read_workload(std::istream &input, std::vector<PCB> &processes);
+
+//What every simulator binary does with its input: check admission, run, and write execution.txt, metrics.txt,
+//memory.txt, devices.txt (when devices are configured) and samples.txt (with --sample-interval). Unless the run needs its trace in memory, parsing,
+//simulation and formatting are pipelined on three threads joined by spsc_rings. Returns the exit code: -1 on an
+//error, 1 if the watchdog stopped the run, else 0.
+int simulate_input_file(Simulator &simulator, const std::string &file_name);
+
+//Bump whenever a change alters any output of a run, so results cached by an older engine stop matching
+const unsigned int ENGINE_VERSION = 3;
+
+//The outputs of a run, as the result cache keeps them
+struct cached_result {
+    std::string execution;
+    std::string metrics;
+    std::string memory;
+    std::string devices;    // empty without devices
+    std::string what_if;    // what_if_summary()
+    std::string latency;    // latency().write(), to merge with the latencies of other runs
+    std::string samples;    // print_load_samples(), empty without --sample-interval
+};
+
+//Results of earlier runs on disk, one file per result_key named after its hash (and holding the key, so a hash
+//collision is a miss). An entry is written to a temporary file and renamed into place, so concurrent runs, batch
+//workers or separate processes, only ever see whole entries. A hit refreshes the entry's modification time and
+//a store evicts the least recently used entries until the directory is back under capacity bytes.
+class result_cache {
+public:
+    result_cache(const std::string &directory, uint64_t capacity) : directory(directory), capacity(capacity) {}
+
+    bool lookup(const std::string &key, cached_result &result) const;
+    void store(const std::string &key, const cached_result &result) const;
+
+private:
+    std::filesystem::path entry_path(const std::string &key) const;
+    void evict() const;
+
+    std::filesystem::path   directory;
+    uint64_t                capacity;
+};
+
+//Load and run workload unless the cache of the simulator's options (--cache=<dir>) has the result already, and
+//fill result either way. Runs the watchdog stopped are not stored, their outputs may depend on the wall clock.
+//Returns the exit code as simulate_input_file.
+int run_cached(Simulator &simulator, const std::vector<PCB> &workload, cached_result &result);
+
+//--------------------------------------------SCHEDULING POLICIES-----------------------------------------
+//Each takes the positional arguments of its binary after the input file; on a bad argument it prints an
+//error and returns nullptr.
+std::unique_ptr<Simulator> make_rr_simulator(const std::vector<std::string> &args, const simulator_options &options);
+std::unique_ptr<Simulator> make_ep_simulator(const std::vector<std::string> &args, const simulator_options &options);
+std::unique_ptr<Simulator> make_ep_rr_simulator(const std::vector<std::string> &args, const simulator_options &options);
+std::unique_ptr<Simulator> make_mlfq_simulator(const std::vector<std::string> &args, const simulator_options &options);
+std::unique_ptr<Simulator> make_srtf_simulator(const std::vector<std::string> &args, const simulator_options &options);
+std::unique_ptr<Simulator> make_cfs_simulator(const std::vector<std::string> &args, const simulator_options &options);
+std::unique_ptr<Simulator> make_edf_simulator(const std::vector<std::string> &args, const simulator_options &options);
+std::unique_ptr<Simulator> make_stride_simulator(const std::vector<std::string> &args, const simulator_options &options);
+
+//Only the RR, EP and EP_RR loops run the medium-term scheduler: for any other policy, prints an error and returns
+//false if the options ask for swapping
+bool swapping_supported(const std::string &policy, const simulator_options &options);
+
+//By name: RR, EP, EP_RR, MLFQ, SRTF, SJF, CFS, EDF, STRIDE or LOTTERY
+std::unique_ptr<Simulator> make_simulator(const std::string &policy, const std::vector<std::string> &args, const simulator_options &options);
+
+//------------------------------------HELPERS FOR THE PCB-COPY SCHEDULERS---------------------------------
+
+//Convert a list of strings into a PCB
+//Columns: PID, size, arrival time, processing time, I/O frequency, I/O duration[, nice[, deadline[, tickets[, device]]]]
+PCB add_process(std::vector<std::string> tokens);
+
+//Returns true if all processes in the queue have terminated
+bool all_process_terminated(std::vector<PCB> processes);
+
 //set the process in the ready queue to runnning
-void run_process(PCB &running, std::vector<PCB> &job_queue, std::vector<PCB> &ready_queue, unsigned int current_time) {
-    running = ready_queue.back();
-    ready_queue.pop_back();
-    running.start_time = current_time;
-    running.state = RUNNING;
-    sync_queue(job_queue, running);
-}
+void run_process(PCB &running, std::vector<PCB> &job_queue, std::vector<PCB> &ready_queue, unsigned int current_time);
 
-void idle_CPU(PCB &running) {
-    running.start_time = 0;
-    running.processing_time = 0;
-    running.remaining_time = 0;
-    running.arrival_time = 0;
-    running.io_duration = 0;
-    running.io_freq = 0;
-    running.partition_number = 0;
-    running.size = 0;
-    running.state = NOT_ASSIGNED;
-    running.PID = -1;
-}
+void idle_CPU(PCB &running);
 
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,162 @@
+#include "interrupts_101268848_101281787.hpp"
+#include <atomic>
+#include <thread>
+
+// Runs many simulations in one process, one Simulator per job on a pool of worker threads.
+// Every line of the jobs file is "<input file> <POLICY> [policy arguments]" (blank lines and lines starting
+// with # are skipped), POLICY as for make_simulator. The simulator options (--memory=, --device=, ...) apply
+// to every job. Job <input stem>_<POLICY>[_<arguments>] writes <name>.txt, <name>_metrics.txt,
+// <name>_memory.txt, with devices <name>_devices.txt and with --sample-interval <name>_samples.txt into the output
+// directory. With --cache=<dir> the
+// workers share the result cache, and jobs it already holds are not simulated again.
+// The latency histograms of all the jobs with the same POLICY [policy arguments] are merged, whatever their input:
+// latency.txt has their percentiles and latency_histograms.txt the merged histograms, a "<POLICY> [arguments]"
+// line and then the waiting, response, turnaround and I/O queueing histogram lines of latency_report::write.
+
+struct batch_job {
+    std::string                 input;
+    std::string                 policy;
+    std::vector<std::string>    args;
+    std::string                 name;
+    std::string                 label;  // POLICY [policy arguments]
+};
+
+bool read_jobs(const std::string &file_name, std::vector<batch_job> &jobs) {
+    std::ifstream jobs_file(file_name);
+    if (!jobs_file.is_open()) {
+        std::cerr << "Error: Unable to open file: " << file_name << std::endl;
+        return false;
+    }
+
+    std::string line;
+    while (std::getline(jobs_file, line)) {
+        std::istringstream fields(line);
+        batch_job job;
+        if (!(fields >> job.input) || job.input[0] == '#') continue;
+        if (!(fields >> job.policy)) {
+            std::cerr << "Error: job \"" << line << "\" has no policy" << std::endl;
+            return false;
+        }
+        job.name = std::filesystem::path(job.input).stem().string() + "_" + job.policy;
+        job.label = job.policy;
+        for (std::string arg; fields >> arg;) {
+            job.args.push_back(arg);
+            job.name += "_" + arg;
+            job.label += " " + arg;
+        }
+        jobs.push_back(job);
+    }
+    return true;
+}
+
+//Returns the exit code of the job, as simulate_input_file, and its latency histograms in latency
+int run_job(const batch_job &job, const simulator_options &options, const std::filesystem::path &output_dir, std::string &latency) {
+    auto simulator = make_simulator(job.policy, job.args, options);
+    if (!simulator) return -1;
+
+    std::vector<PCB> list_process;
+    if (!read_workload(job.input, list_process) || !simulator->admission_feasible(list_process)) return -1;
+    cached_result result;
+    int status = run_cached(*simulator, list_process, result);
+    if (status < 0) return -1;
+    latency = result.latency;
+
+    // not write_output, its messages would interleave between the workers
+    bool written = true;
+    auto output = [&](const std::string &suffix, const std::string &content){
+        std::ofstream output_file(output_dir / (job.name + suffix));
+        output_file << content;
+        if (!output_file) {
+            std::cerr << "Error: unable to write " << (output_dir / (job.name + suffix)).string() << std::endl;
+            written = false;
+        }
+    };
+    output(".txt", result.execution);
+    output("_metrics.txt", result.metrics);
+    output("_memory.txt", result.memory);
+    if (simulator->has_devices()) output("_devices.txt", result.devices);
+    if (simulator->has_samples()) output("_samples.txt", result.samples);
+    return written ? status : -1;
+}
+
+//Merge the latencies of the jobs per label, in the order the labels first appear; false if a file cannot be written
+bool write_latencies(const std::vector<batch_job> &jobs, const std::vector<std::string> &latencies, const std::filesystem::path &output_dir) {
+    std::vector<std::string> labels;
+    std::unordered_map<std::string, latency_report> merged;
+    for (size_t j = 0; j < jobs.size(); j++) {
+        std::istringstream encoded(latencies[j]);
+        latency_report report;
+        if (!report.read(encoded)) continue;    // failed jobs have none
+        if (merged.count(jobs[j].label) == 0) labels.push_back(jobs[j].label);
+        merged[jobs[j].label].merge(report);
+    }
+
+    std::ostringstream table, histograms;
+    for (auto &label : labels) {
+        table << label << std::endl << print_latency_report(merged[label]) << std::endl;
+        histograms << label << std::endl;
+        merged[label].write(histograms);
+    }
+
+    bool written = true;
+    for (auto &output : {std::make_pair("latency.txt", &table), std::make_pair("latency_histograms.txt", &histograms)}) {
+        std::ofstream output_file(output_dir / output.first);
+        output_file << output.second->str();
+        if (!output_file) {
+            std::cerr << "Error: unable to write " << (output_dir / output.first).string() << std::endl;
+            written = false;
+        }
+    }
+    return written;
+}
+
+int main(int argc, char** argv) {
+    simulator_options options;
+    argc = parse_simulator_options(argc, argv, options);
+    if (argc < 0) return -1;
+
+    if(argc < 3 || argc > 4) {
+        std::cout << "ERROR!\nExpected 2 or 3 arguments, received " << argc - 1 << std::endl;
+        std::cout << "To run the program, do: ./interrupts_BATCH <jobs_file.txt> <output_dir> [threads]" << std::endl;
+        return -1;
+    }
+    if (!options.checkpoint_path.empty() || !options.resume_path.empty() || !options.trace_index_path.empty()) {
+        std::cerr << "Error: --checkpoint, --resume and --trace-index name a single run and cannot be used with a batch" << std::endl;
+        return -1;
+    }
+
+    unsigned int threads = std::thread::hardware_concurrency();
+    if (argc == 4 && !parse_number("threads", argv[3], threads, 1)) return -1;
+
+    std::vector<batch_job> jobs;
+    if (!read_jobs(argv[1], jobs)) return -1;
+    std::filesystem::path output_dir = argv[2];
+    std::filesystem::create_directories(output_dir);
+
+    threads = std::max(1u, std::min<unsigned int>(threads, jobs.size()));
+
+    // workers claim jobs by index and hand (job, exit code) back to this thread, which does all the printing
+    // and each leaves the latencies of job j in latencies[j]
+    std::atomic<size_t> next_job(0);
+    mpsc_ring<std::pair<size_t, int>> results(jobs.size());
+    std::vector<std::string> latencies(jobs.size());
+    auto worker = [&](){
+        for (size_t j; (j = next_job++) < jobs.size();) results.push({j, run_job(jobs[j], options, output_dir, latencies[j])});
+    };
+
+    std::vector<std::thread> pool;
+    for (unsigned int t = 0; t < threads; t++) pool.emplace_back(worker);
+
+    bool any_failed = false;
+    for (size_t reported = 0; reported < jobs.size(); reported++) {
+        std::pair<size_t, int> result;
+        while (!results.try_pop(result)) std::this_thread::yield();
+        int status = result.second;
+        if (status != 0) any_failed = true;
+        std::cout << jobs[result.first].name << ": " << (status == 0 ? "done" : status == 1 ? "stopped by the watchdog" : "failed") << std::endl;
+    }
+    for (auto &thread : pool) thread.join();
+    if (!write_latencies(jobs, latencies, output_dir)) any_failed = true;
+
+    return any_failed ? 1 : 0;
+}
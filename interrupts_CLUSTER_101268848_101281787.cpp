@@ -0,0 +1,243 @@
+#include "interrupts_101268848_101281787.hpp"
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+// Simulates a cluster: every host is a single-CPU Simulator running the same policy, and a front-end router
+// places each job of the workload on a host when the job arrives. A routed job reaches its host after the
+// dispatch latency, --lookahead=<ms> (default 10), and that latency is what lets the hosts run in parallel:
+// the router decides at the start of every window of lookahead ms, from the hosts' state at that instant,
+// where the jobs arriving during the window go, and none of them reaches a host before the window is over.
+// So within a window no host can affect another, every host simulates it on its own, and the router waits
+// for all of them at the window boundary (conservative synchronization with a fixed lookahead, as YAWNS).
+// The result depends only on the lookahead, never on --threads or on which thread ran which host.
+//
+// --route=least-loaded (default) sends a job to the host with the fewest unfinished processes, lowest index
+// on a tie; --route=round-robin ignores the hosts' state. --threads=<n> shards the hosts over n threads
+// (default: one per core). Host <h> writes host<h>.txt, host<h>_metrics.txt, host<h>_memory.txt, with devices
+// host<h>_devices.txt, with --sample-interval host<h>_samples.txt, and host<h>_workload.txt: the jobs it received, with their arrival at the host, which
+// the single-host binary of the policy can run on its own to reproduce host<h>.txt. The latency histograms of
+// all the hosts are merged into latency.txt (percentiles) and latency_histograms.txt (latency_report::write).
+
+const unsigned int CLUSTER_DEFAULT_LOOKAHEAD = 10;
+
+enum route_policy {
+    LEAST_LOADED,
+    ROUND_ROBIN
+};
+
+struct cluster_config {
+    unsigned int    hosts = 0;
+    unsigned int    threads = 0;
+    unsigned int    lookahead = CLUSTER_DEFAULT_LOOKAHEAD;
+    route_policy    route = LEAST_LOADED;
+};
+
+//Takes the cluster options out of argv like parse_simulator_options; returns the new argc, -1 on an error
+int parse_cluster_options(int argc, char** argv, cluster_config &config) {
+    int kept = 1;
+    for (int i = 1; i < argc; i++) {
+        std::string option = argv[i];
+        if (option.rfind("--threads=", 0) == 0) {
+            if (!parse_number("--threads", option.substr(10), config.threads, 1)) return -1;
+        } else if (option.rfind("--lookahead=", 0) == 0) {
+            // at least 1 ms: a job cannot reach its host the instant it arrives
+            if (!parse_number("--lookahead", option.substr(12), config.lookahead, 1)) return -1;
+        } else if (option.rfind("--route=", 0) == 0) {
+            std::string route = option.substr(8);
+            if (route == "least-loaded") config.route = LEAST_LOADED;
+            else if (route == "round-robin") config.route = ROUND_ROBIN;
+            else {
+                std::cerr << "Error: unknown routing policy " << route << ", expected least-loaded or round-robin" << std::endl;
+                return -1;
+            }
+        } else {
+            argv[kept++] = argv[i];
+        }
+    }
+    return kept;
+}
+
+//One round per window: the router and every worker thread meet here before and after the window
+class window_barrier {
+public:
+    explicit window_barrier(size_t parties) : parties(parties) {}
+
+    void arrive_and_wait() {
+        std::unique_lock<std::mutex> lock(mutex);
+        size_t round = generation;
+        if (++arrived == parties) {
+            arrived = 0;
+            generation++;
+            released.notify_all();
+            return;
+        }
+        released.wait(lock, [&]{ return generation != round; });
+    }
+
+private:
+    std::mutex              mutex;
+    std::condition_variable released;
+    size_t                  parties;
+    size_t                  arrived = 0;
+    size_t                  generation = 0;
+};
+
+struct cluster_host {
+    std::unique_ptr<Simulator>  simulator;
+    std::vector<PCB>            received;   // as delivered, arrival at the host
+};
+
+size_t route_job(const std::vector<cluster_host> &hosts, route_policy route, size_t job) {
+    if (route == ROUND_ROBIN) return job % hosts.size();
+    size_t best = 0;
+    for (size_t h = 1; h < hosts.size(); h++) {
+        if (hosts[h].simulator->unfinished() < hosts[best].simulator->unfinished()) best = h;
+    }
+    return best;
+}
+
+std::string print_workload(const std::vector<PCB> &processes) {
+    std::ostringstream workload;
+    for (const auto &p : processes) {
+        workload << p.PID << ", " << p.size << ", " << p.arrival_time << ", " << p.processing_time << ", "
+                 << p.io_freq << ", " << p.io_duration << ", " << p.nice << ", " << p.deadline << ", "
+                 << p.tickets << ", " << p.device << std::endl;
+    }
+    return workload.str();
+}
+
+//Returns the exit code of the host, as simulate_input_file
+int write_host(const cluster_host &host, const std::filesystem::path &output_dir, const std::string &name) {
+    bool written = true;
+    auto output = [&](const std::string &suffix, const std::string &content){
+        std::ofstream output_file(output_dir / (name + suffix));
+        output_file << content;
+        if (!output_file) {
+            std::cerr << "Error: unable to write " << (output_dir / (name + suffix)).string() << std::endl;
+            written = false;
+        }
+    };
+    output(".txt", host.simulator->execution());
+    output("_metrics.txt", host.simulator->print_process_metrics());
+    output("_memory.txt", host.simulator->print_memory_log());
+    if (host.simulator->has_devices()) output("_devices.txt", host.simulator->print_device_stats());
+    if (host.simulator->has_samples()) output("_samples.txt", host.simulator->print_load_samples());
+    output("_workload.txt", print_workload(host.received));
+    if (!written) return -1;
+    return host.simulator->stopped_by_watchdog() ? 1 : 0;
+}
+
+int main(int argc, char** argv) {
+    simulator_options options;
+    argc = parse_simulator_options(argc, argv, options);
+    if (argc < 0) return -1;
+    cluster_config config;
+    argc = parse_cluster_options(argc, argv, config);
+    if (argc < 0) return -1;
+
+    if(argc < 5) {
+        std::cout << "ERROR!\nExpected at least 4 arguments, received " << argc - 1 << std::endl;
+        std::cout << "To run the program, do: ./interrupts_CLUSTER <your_input_file.txt> <hosts> <output_dir> <POLICY> [policy arguments]"
+                  << " [--lookahead=<ms>] [--route=least-loaded|round-robin] [--threads=<n>]" << std::endl;
+        return -1;
+    }
+    if (!options.checkpoint_path.empty() || !options.resume_path.empty() || options.what_if.active || !options.trace_index_path.empty()) {
+        std::cerr << "Error: --checkpoint, --resume, --what-if and --trace-index name a single run and cannot be used with a cluster" << std::endl;
+        return -1;
+    }
+    if (!parse_number("hosts", argv[2], config.hosts, 1)) return -1;
+
+    std::vector<cluster_host> hosts(config.hosts);
+    for (auto &host : hosts) {
+        host.simulator = make_simulator(argv[4], std::vector<std::string>(argv + 5, argv + argc), options);
+        if (!host.simulator) return -1;
+    }
+
+    std::vector<PCB> jobs;
+    if (!read_workload(argv[1], jobs) || !hosts[0].simulator->admission_feasible(jobs)) return -1;
+    std::stable_sort(jobs.begin(), jobs.end(), [](const PCB &a, const PCB &b){ return a.arrival_time < b.arrival_time; });
+    std::filesystem::path output_dir = argv[3];
+    std::filesystem::create_directories(output_dir);
+
+    for (auto &host : hosts) {
+        host.simulator->hold_arrivals(true);
+        host.simulator->load({});
+    }
+
+    unsigned int threads = config.threads ? config.threads : std::thread::hardware_concurrency();
+    threads = std::max(1u, std::min<unsigned int>(threads, hosts.size()));
+
+    // thread t simulates hosts t, t + threads, ...; the router is thread 0 and simulates its share too.
+    // window_end and last_window are only written while the workers wait at the barrier.
+    window_barrier barrier(threads);
+    unsigned int window_end = 0;
+    bool last_window = false;
+    auto simulate_shard = [&](unsigned int t){
+        for (size_t h = t; h < hosts.size(); h += threads) {
+            if (last_window) hosts[h].simulator->run();
+            else hosts[h].simulator->run_until(window_end);
+        }
+    };
+    auto worker = [&](unsigned int t){
+        for (bool last = false; !last;) {
+            barrier.arrive_and_wait();
+            simulate_shard(t);
+            last = last_window;
+            barrier.arrive_and_wait();
+        }
+    };
+    std::vector<std::thread> pool;
+    for (unsigned int t = 1; t < threads; t++) pool.emplace_back(worker, t);
+
+    // each window: route the jobs arriving in [now, now + lookahead), which reach their hosts in the next
+    // window, then let every host simulate this one. A stretch with no arrivals is one long window.
+    size_t next_job = 0;
+    for (unsigned int now = 0; !last_window; now = window_end) {
+        for (; next_job < jobs.size() && jobs[next_job].arrival_time < now + config.lookahead; next_job++) {
+            auto &host = hosts[route_job(hosts, config.route, next_job)];
+            PCB job = jobs[next_job];
+            job.arrival_time += config.lookahead;
+            host.simulator->deliver(job);
+            host.received.push_back(job);
+        }
+
+        if (next_job == jobs.size()) {
+            for (auto &host : hosts) host.simulator->hold_arrivals(false);
+            last_window = true;
+        } else {
+            unsigned int next_arrival = jobs[next_job].arrival_time;
+            window_end = std::max(now + config.lookahead, next_arrival - next_arrival % config.lookahead);
+        }
+
+        barrier.arrive_and_wait();
+        simulate_shard(0);
+        barrier.arrive_and_wait();
+    }
+    for (auto &thread : pool) thread.join();
+
+    bool any_failed = false;
+    latency_report latency;
+    for (size_t h = 0; h < hosts.size(); h++) {
+        std::string name = "host" + std::to_string(h);
+        int status = hosts[h].simulator->failed() ? -1 : write_host(hosts[h], output_dir, name);
+        if (status != 0) any_failed = true;
+        if (!hosts[h].simulator->failed()) latency.merge(hosts[h].simulator->latency());
+        std::cout << name << ": " << hosts[h].received.size() << " job(s), "
+                  << (status == 0 ? "done at " + std::to_string(hosts[h].simulator->now()) + " ms"
+                                  : status == 1 ? "stopped by the watchdog" : "failed") << std::endl;
+    }
+
+    std::ostringstream histograms;
+    latency.write(histograms);
+    for (auto &output : {std::make_pair("latency.txt", print_latency_report(latency)), std::make_pair("latency_histograms.txt", histograms.str())}) {
+        std::ofstream output_file(output_dir / output.first);
+        output_file << output.second;
+        if (!output_file) {
+            std::cerr << "Error: unable to write " << (output_dir / output.first).string() << std::endl;
+            any_failed = true;
+        }
+    }
+
+    return any_failed ? 1 : 0;
+}
@@ -0,0 +1,486 @@
+#include "interrupts_101268848_101281787.hpp"
+
+// Differential check of the faster ways to run a simulation against the plain one. The reference is a fresh
+// Simulator stepping tick by tick from load() to the end; every engine below must produce the same execution
+// table, byte for byte, on thousands of random workloads per policy (random memory model, paging, swapping and
+// devices as well):
+//   steps    the trace taken from a trace_sink with keep_trace(false), the run driven by run_until() in windows
+//   reload   a warm simulator that already ran another workload, as the server and the batch runner reuse them
+//   resume   a run with checkpoints abandoned part way through, then resumed from the last checkpoint
+//   what-if  a --what-if run (re-simulation from a snapshot, stopped at re-convergence) against a full run of
+//            the changed workload
+//   streamed the workload streamed in input order, as a plain run reads its input file, and sometimes out of
+//            arrival order so that the stream breaks and the run starts over
+// A mismatch is shrunk to a minimal reproducer: processes are dropped, the fields of the rest pulled toward their
+// simplest values and options dropped for as long as the engine still disagrees. <out>/<POLICY>_<engine>_<case>.txt
+// is the workload and .cmd the command lines to replay it. Cases are spread over --threads workers (default one per
+// core) and derived from --seed alone, so a run gives the same cases whatever the thread count.
+
+const std::vector<std::string> DIFF_POLICIES = {"EP", "RR", "EP_RR", "MLFQ", "SRTF", "SJF", "CFS", "EDF", "STRIDE", "LOTTERY"};
+const std::vector<std::string> DIFF_ENGINES = {"steps", "reload", "resume", "what-if", "streamed"};
+const size_t DIFF_DEFAULT_CASES = 1000;         // per policy and engine
+const unsigned int DIFF_TIME_LIMIT = 100000;    // a reference still running here is skipped, not compared
+const unsigned int DIFF_MAX_SIZE = 25;          // fits every memory model below
+const size_t DIFF_SHRINK_RUNS = 5000;
+
+struct diff_case {
+    std::string                 policy;
+    std::vector<std::string>    options;        // simulator options, as on the command line
+    unsigned int                devices = 0;    // --device options among them
+    std::vector<PCB>            workload;
+
+    std::vector<PCB>            warmup;         // reload: what the simulator ran before
+    unsigned int                window = 1;     // steps: ms per run_until()
+    unsigned int                interval = 1;   // resume and what-if: ms between checkpoints (snapshots)
+    unsigned int                stop = 0;       // resume: the checkpointing run is abandoned here
+    std::string                 what_if;        // what-if: <PID>:<field>=<value>
+    std::string                 checkpoint;     // resume: file, one per case
+};
+
+enum diff_outcome {
+    SKIPPED,        // nothing to compare: the case is infeasible, or too long, or wrote no checkpoint
+    SAME,
+    DIFFERENT
+};
+
+PCB make_process(int PID, unsigned int size, unsigned int arrival, unsigned int processing, unsigned int io_freq,
+                 unsigned int io_duration, int nice, unsigned int deadline, unsigned int tickets, int device) {
+    PCB process{};
+    process.PID = PID;
+    process.size = size;
+    process.arrival_time = arrival;
+    process.processing_time = process.remaining_time = processing;
+    process.io_freq = io_freq;
+    process.io_duration = io_duration;
+    process.nice = nice;
+    process.deadline = deadline;
+    process.tickets = tickets;
+    process.device = device;
+    process.start_time = -1;
+    process.partition_number = -1;
+    process.state = NOT_ASSIGNED;
+    return process;
+}
+
+std::vector<PCB> random_workload(std::mt19937_64 &random, size_t max_processes, unsigned int devices) {
+    auto uniform = [&](int low, int high){ return std::uniform_int_distribution<int>(low, high)(random); };
+    std::vector<PCB> workload;
+    unsigned int arrival = 0;
+    for (int PID = 1, count = uniform(1, max_processes); PID <= count; PID++) {
+        unsigned int processing = uniform(1, 80);
+        workload.push_back(make_process(PID, uniform(1, DIFF_MAX_SIZE), arrival, processing,
+                                        uniform(0, 2) == 0 ? 0 : uniform(1, 30), uniform(1, 25),
+                                        uniform(0, 1) ? 0 : uniform(-20, 19), uniform(0, 1) ? 0 : processing * uniform(1, 5),
+                                        uniform(1, 300), devices ? uniform(0, devices - 1) : 0));
+        arrival += uniform(0, 40);
+    }
+    return workload;
+}
+
+std::vector<std::string> random_options(std::mt19937_64 &random, unsigned int &devices, bool swapping) {
+    auto uniform = [&](int low, int high){ return std::uniform_int_distribution<int>(low, high)(random); };
+    const char* const models[] = {"fixed", "fixed", "first-fit", "best-fit", "next-fit", "buddy", "paged", "paged"};
+    const char* const replacements[] = {"fifo", "lru", "clock"};
+    std::vector<std::string> options;
+    std::string model = models[uniform(0, 7)];
+    options.push_back("--memory=" + model);
+    if (model == "paged") {
+        options.push_back("--frames=" + std::to_string(uniform(DIFF_MAX_SIZE, 64)));
+        options.push_back("--replacement=" + std::string(replacements[uniform(0, 2)]));
+        options.push_back("--tlb-size=" + std::to_string(uniform(0, 16)));
+        options.push_back("--page-fault-time=" + std::to_string(uniform(1, 10)));
+    }
+    if (uniform(0, 2) == 0 && swapping) options.push_back("--swap");   // only RR, EP and EP_RR swap
+    devices = uniform(0, 3) == 0 ? 0 : uniform(1, 2);
+    for (unsigned int d = 0; d < devices; d++) {
+        options.push_back("--device=dev" + std::to_string(d) + ":" + std::to_string(uniform(1, 2)) + (uniform(0, 1) ? ":fifo" : ":elevator"));
+    }
+    return options;
+}
+
+diff_case random_case(uint64_t seed, size_t policy, size_t engine, size_t index) {
+    std::seed_seq sequence{seed, (uint64_t)policy, (uint64_t)engine, (uint64_t)index};
+    std::mt19937_64 random(sequence);
+    auto uniform = [&](int low, int high){ return std::uniform_int_distribution<int>(low, high)(random); };
+
+    diff_case c;
+    c.policy = DIFF_POLICIES[policy];
+    c.options = random_options(random, c.devices, c.policy == "RR" || c.policy == "EP" || c.policy == "EP_RR");
+    c.workload = random_workload(random, 12, c.devices);
+    c.warmup = random_workload(random, 8, c.devices);
+    c.window = uniform(1, 50);
+    c.interval = uniform(1, 100);
+    c.stop = uniform(1, 400);
+
+    // a change to one field of one process, within the ranges of random_workload
+    const PCB &changed = c.workload[uniform(0, c.workload.size() - 1)];
+    std::string field;
+    do field = WHAT_IF_FIELDS[uniform(0, WHAT_IF_FIELDS.size() - 1)]; while (field == "device" && c.devices == 0);
+    int value = field == "size" ? uniform(1, DIFF_MAX_SIZE) : field == "arrival" ? uniform(0, 300) : field == "burst" ? uniform(1, 80) :
+                field == "io-freq" ? uniform(0, 30) : field == "io-duration" ? uniform(1, 25) : field == "nice" ? uniform(-20, 19) :
+                field == "deadline" ? uniform(0, 200) : field == "tickets" ? uniform(1, 300) : uniform(0, c.devices - 1);
+    c.what_if = std::to_string(changed.PID) + ":" + field + "=" + std::to_string(value);
+
+    // an input out of arrival order, which cannot be streamed to the end
+    if (DIFF_ENGINES[engine] == "streamed" && c.workload.size() > 1 && uniform(0, 2) == 0) {
+        std::swap(c.workload[uniform(0, c.workload.size() - 1)], c.workload[uniform(0, c.workload.size() - 1)]);
+    }
+    return c;
+}
+
+//Admission_feasible() without its messages: every size fits and every device exists
+bool feasible(const diff_case &c, const std::vector<PCB> &workload) {
+    return std::all_of(workload.begin(), workload.end(), [&](const PCB &p){
+        return p.size >= 1 && p.size <= DIFF_MAX_SIZE && (c.devices == 0 || p.io_freq == 0 || (p.device >= 0 && (unsigned int)p.device < c.devices));
+    });
+}
+
+std::unique_ptr<Simulator> case_simulator(const diff_case &c, const std::vector<std::string> &extra = {}) {
+    std::vector<std::string> argv_text = {"interrupts_DIFF"};
+    argv_text.insert(argv_text.end(), c.options.begin(), c.options.end());
+    argv_text.insert(argv_text.end(), extra.begin(), extra.end());
+    std::vector<char*> argv;
+    for (auto &argument : argv_text) argv.push_back(&argument[0]);
+    simulator_options options;
+    if (parse_simulator_options(argv.size(), argv.data(), options) < 0) return nullptr;
+    return make_simulator(c.policy, {}, options);
+}
+
+//The trace of a plain run, false if it did not end by DIFF_TIME_LIMIT
+bool reference_run(const diff_case &c, const std::vector<PCB> &workload, std::string &trace) {
+    auto simulator = case_simulator(c);
+    if (!simulator) return false;
+    simulator->load(workload);
+    simulator->run_until(DIFF_TIME_LIMIT);
+    if (!simulator->finished() || simulator->failed()) return false;
+    trace = simulator->execution();
+    return true;
+}
+
+struct collected_trace : trace_sink {
+    std::string text;
+    void transition(unsigned int time, int PID, states old_state, states new_state) override {
+        text += print_exec_status(time, PID, old_state, new_state);
+    }
+    void restart() override { text.clear(); }
+};
+
+//The trace the engine produces for c, or why it produced none in trace
+diff_outcome candidate_run(const diff_case &c, const std::string &engine, std::string &trace) {
+    if (engine == "steps") {
+        auto simulator = case_simulator(c);
+        collected_trace sink;
+        simulator->keep_trace(false);
+        simulator->attach_trace(sink);
+        simulator->load(c.workload);
+        while (!simulator->finished()) simulator->run_until(simulator->now() + c.window);
+        trace = simulator->failed() ? "(failed)" : print_exec_header() + sink.text + print_exec_footer();
+    } else if (engine == "streamed") {
+        auto simulator = case_simulator(c);
+        collected_trace sink;
+        simulator->keep_trace(false);
+        simulator->attach_trace(sink);
+        simulator->start_stream();
+        for (auto &process : c.workload) simulator->stream(process);
+        simulator->finish_stream(c.workload);
+        trace = simulator->failed() ? "(failed)" : print_exec_header() + sink.text + print_exec_footer();
+    } else if (engine == "reload") {
+        auto simulator = case_simulator(c);
+        simulator->load(c.warmup);
+        simulator->run_until(DIFF_TIME_LIMIT);
+        simulator->load(c.workload);
+        simulator->run();
+        trace = simulator->failed() ? "(failed)" : simulator->execution();
+    } else if (engine == "resume") {
+        auto remove_checkpoint = [&]{
+            for (auto suffix : {"", ".trace", ".tmp"}) std::filesystem::remove(c.checkpoint + suffix);
+        };
+        remove_checkpoint();
+        {
+            auto simulator = case_simulator(c, {"--checkpoint=" + c.checkpoint, "--checkpoint-interval=" + std::to_string(c.interval)});
+            simulator->load(c.workload);
+            simulator->run_until(c.stop);
+        }
+        if (!std::filesystem::exists(c.checkpoint)) {
+            remove_checkpoint();
+            return SKIPPED;
+        }
+        auto simulator = case_simulator(c, {"--resume=" + c.checkpoint});
+        simulator->load(c.workload);
+        simulator->run();
+        remove_checkpoint();
+        trace = simulator->failed() ? "(failed)" : simulator->execution();
+    } else {
+        auto simulator = case_simulator(c, {"--what-if=" + c.what_if, "--checkpoint-interval=" + std::to_string(c.interval)});
+        simulator->load(c.workload);
+        simulator->run();
+        trace = simulator->failed() ? "(failed)" : simulator->execution();
+    }
+    return SAME;
+}
+
+//The workload the reference runs for c under engine
+std::vector<PCB> reference_workload(const diff_case &c, const std::string &engine) {
+    std::vector<PCB> workload = c.workload;
+    if (engine != "what-if") return workload;
+    what_if_change change;
+    change.PID = std::stoi(c.what_if);
+    auto assignment = split_delim(c.what_if.substr(c.what_if.find(':') + 1), "=");
+    change.fields.push_back({assignment[0], std::stol(assignment[1])});
+    for (auto &p : workload) {
+        if (p.PID == change.PID) apply_what_if(change, p);
+    }
+    return workload;
+}
+
+diff_outcome compare(const diff_case &c, const std::string &engine, std::string *detail = nullptr) {
+    std::vector<PCB> changed = reference_workload(c, engine);
+    if (!feasible(c, c.workload) || !feasible(c, changed)) return SKIPPED;
+    if (engine == "what-if" && std::none_of(c.workload.begin(), c.workload.end(), [&](const PCB &p){ return p.PID == std::stoi(c.what_if); })) return SKIPPED;
+    if (engine == "reload" && !feasible(c, c.warmup)) return SKIPPED;
+
+    std::string expected, actual, unchanged;
+    if (!reference_run(c, changed, expected)) return SKIPPED;
+    // the what-if and warm-up runs go to the end as well
+    if (engine == "what-if" && !reference_run(c, c.workload, unchanged)) return SKIPPED;
+    if (engine == "reload" && !reference_run(c, c.warmup, unchanged)) return SKIPPED;
+    if (candidate_run(c, engine, actual) == SKIPPED) return SKIPPED;
+    if (actual == expected) return SAME;
+
+    if (detail) {
+        // the first line that differs
+        std::istringstream a(expected), b(actual);
+        std::string line_a, line_b;
+        size_t line = 1;
+        for (; std::getline(a, line_a); line++) {
+            if (!std::getline(b, line_b) || line_a != line_b) break;
+            line_b.clear();
+        }
+        *detail = "line " + std::to_string(line) + ": expected \"" + line_a + "\", got \"" + line_b + "\"";
+    }
+    return DIFFERENT;
+}
+
+//Greedy shrinking: fewer processes (halves, quarters, ... down to one at a time), then every field of every process
+//toward its simplest value, then fewer options, for as long as anything is accepted. A step is kept when the engine
+//still disagrees with the reference.
+diff_case shrink(diff_case c, const std::string &engine) {
+    size_t runs = 0;
+    auto still_fails = [&](const diff_case &candidate){
+        return runs++ < DIFF_SHRINK_RUNS && compare(candidate, engine) == DIFFERENT;
+    };
+
+    using field_step = std::function<bool(PCB&)>;   // false if it changes nothing
+    const std::vector<field_step> simplify = {
+        [](PCB &p){ return p.io_freq != 0 && (p.io_freq = 0, true); },
+        [](PCB &p){ return p.io_duration > 1 && (p.io_duration = 1, true); },
+        [](PCB &p){ return p.io_duration > 1 && (p.io_duration /= 2, true); },
+        [](PCB &p){ return p.processing_time > 1 && (p.processing_time = p.remaining_time = 1, true); },
+        [](PCB &p){ return p.processing_time > 1 && (p.processing_time = p.remaining_time = p.processing_time / 2, true); },
+        [](PCB &p){ return p.processing_time > 1 && (p.processing_time = p.remaining_time = p.processing_time - 1, true); },
+        [](PCB &p){ return p.arrival_time > 0 && (p.arrival_time = 0, true); },
+        [](PCB &p){ return p.arrival_time > 0 && (p.arrival_time /= 2, true); },
+        [](PCB &p){ return p.size > 1 && (p.size = 1, true); },
+        [](PCB &p){ return p.size > 1 && (p.size /= 2, true); },
+        [](PCB &p){ return p.nice != 0 && (p.nice = 0, true); },
+        [](PCB &p){ return p.deadline != 0 && (p.deadline = 0, true); },
+        [](PCB &p){ return p.tickets != 100 && (p.tickets = 100, true); },
+        [](PCB &p){ return p.device != 0 && (p.device = 0, true); },
+    };
+
+    for (bool progress = true; progress && runs < DIFF_SHRINK_RUNS;) {
+        progress = false;
+        for (size_t chunk = std::max<size_t>(c.workload.size() / 2, 1); chunk >= 1; chunk /= 2) {
+            for (size_t from = 0; from < c.workload.size() && c.workload.size() > 1;) {
+                diff_case smaller = c;
+                smaller.workload.erase(smaller.workload.begin() + from, smaller.workload.begin() + std::min(from + chunk, c.workload.size()));
+                if (!smaller.workload.empty() && still_fails(smaller)) {
+                    c = smaller;
+                    progress = true;
+                } else {
+                    from += chunk;
+                }
+            }
+            if (chunk == 1) break;
+        }
+        for (size_t p = 0; p < c.workload.size(); p++) {
+            for (auto &step : simplify) {
+                diff_case simpler = c;
+                while (step(simpler.workload[p]) && still_fails(simpler)) {
+                    c = simpler;
+                    progress = true;
+                }
+            }
+        }
+        for (size_t o = 0; o < c.options.size();) {
+            diff_case fewer = c;
+            fewer.options.erase(fewer.options.begin() + o);
+            fewer.devices = std::count_if(fewer.options.begin(), fewer.options.end(), [](const std::string &option){ return option.rfind("--device=", 0) == 0; });
+            if (still_fails(fewer)) {
+                c = fewer;
+                progress = true;
+            } else {
+                o++;
+            }
+        }
+    }
+    return c;
+}
+
+std::string print_workload(const std::vector<PCB> &processes) {
+    std::ostringstream workload;
+    for (const auto &p : processes) {
+        workload << p.PID << ", " << p.size << ", " << p.arrival_time << ", " << p.processing_time << ", "
+                 << p.io_freq << ", " << p.io_duration << ", " << p.nice << ", " << p.deadline << ", "
+                 << p.tickets << ", " << p.device << std::endl;
+    }
+    return workload.str();
+}
+
+//Writes <name>.txt (and what the engine needs besides) and <name>.cmd into output_dir; false if it cannot
+bool write_reproducer(const diff_case &c, const std::string &engine, const std::string &detail,
+                      const std::filesystem::path &output_dir, const std::string &name) {
+    // the SRTF and STRIDE binaries run SJF and LOTTERY as modes
+    std::string binary = c.policy == "SJF" ? "SRTF" : c.policy == "LOTTERY" ? "STRIDE" : c.policy;
+    std::string mode = c.policy == "SJF" ? " sjf" : c.policy == "LOTTERY" ? " lottery" : c.policy == "SRTF" ? " srtf" : "";
+    std::string options;
+    for (auto &option : c.options) options += " " + option;
+    auto command = [&](const std::string &workload, const std::string &extra){
+        return "./bin/interrupts_" + binary + "_101268848_101281787 " + workload + mode + options + extra + "\n";
+    };
+
+    std::ostringstream commands;
+    commands << "# " << c.policy << ", engine " << engine << ": " << detail << "\n# reference\n";
+    std::vector<std::pair<std::string, std::string>> files = {{name + ".txt", print_workload(c.workload)}};
+    if (engine == "what-if") {
+        files.push_back({name + "_changed.txt", print_workload(reference_workload(c, engine))});
+        commands << command(name + "_changed.txt", "") << "# what-if\n"
+                 << command(name + ".txt", " --what-if=" + c.what_if + " --checkpoint-interval=" + std::to_string(c.interval));
+    } else if (engine == "resume") {
+        commands << command(name + ".txt", "") << "# checkpoints, stopped at " << c.stop << " ms, then resumed\n"
+                 << command(name + ".txt", " --checkpoint=" + name + ".ckpt --checkpoint-interval=" + std::to_string(c.interval) + " --time-limit=" + std::to_string(c.stop))
+                 << command(name + ".txt", " --resume=" + name + ".ckpt");
+    } else if (engine == "streamed") {
+        // a run that keeps its trace (here for the cache) loads the whole workload up front
+        commands << command(name + ".txt", " --cache=" + name + "_cache") << "# streamed, as a plain run reads its input\n"
+                 << command(name + ".txt", "");
+    } else if (engine == "reload") {
+        files.push_back({name + "_warmup.txt", print_workload(c.warmup)});
+        commands << command(name + ".txt", "") << "# the same simulator loads and runs " << name << "_warmup.txt first, then "
+                 << name << ".txt\n";
+    } else {
+        commands << command(name + ".txt", "") << "# the same run with keep_trace(false), its trace from a trace_sink, stepped with run_until() "
+                 << c.window << " ms at a time\n";
+    }
+    files.push_back({name + ".cmd", commands.str()});
+
+    bool written = true;
+    for (auto &file : files) {
+        std::ofstream output_file(output_dir / file.first);
+        output_file << file.second;
+        if (!output_file) {
+            std::cerr << "Error: unable to write " << (output_dir / file.first).string() << std::endl;
+            written = false;
+        }
+    }
+    return written;
+}
+
+std::vector<std::string> select(const std::string &list, const std::vector<std::string> &known, const std::string &what) {
+    std::vector<std::string> selected = split_delim(list, ",");
+    for (auto &name : selected) {
+        if (std::find(known.begin(), known.end(), name) == known.end()) {
+            std::cerr << "Error: unknown " << what << " " << name << std::endl;
+            return {};
+        }
+    }
+    return selected;
+}
+
+int main(int argc, char** argv) {
+    size_t cases = DIFF_DEFAULT_CASES;
+    uint64_t seed = 1;
+    unsigned int threads = std::thread::hardware_concurrency();
+    std::vector<std::string> policies = DIFF_POLICIES, engines = DIFF_ENGINES;
+    std::filesystem::path output_dir = "diff_failures";
+    for (int i = 1; i < argc; i++) {
+        std::string option = argv[i];
+        if (option.rfind("--cases=", 0) == 0) cases = std::stoul(option.substr(8));
+        else if (option.rfind("--seed=", 0) == 0) seed = std::stoull(option.substr(7));
+        else if (option.rfind("--threads=", 0) == 0) threads = std::stoul(option.substr(10));
+        else if (option.rfind("--policies=", 0) == 0) policies = select(option.substr(11), DIFF_POLICIES, "policy");
+        else if (option.rfind("--engines=", 0) == 0) engines = select(option.substr(10), DIFF_ENGINES, "engine");
+        else if (option.rfind("--out=", 0) == 0) output_dir = option.substr(6);
+        else {
+            std::cout << "ERROR!\nUnknown argument " << option << std::endl;
+            std::cout << "To run the program, do: ./interrupts_DIFF [--cases=<n per policy and engine>] [--seed=<n>] [--threads=<n>]"
+                      << " [--policies=EP,RR,...] [--engines=steps,reload,resume,what-if,streamed] [--out=<dir>]" << std::endl;
+            return -1;
+        }
+    }
+    if (policies.empty() || engines.empty()) return -1;
+    threads = std::max(1u, threads);
+
+    // every case on its own, then the first mismatch of every (policy, engine) shrunk
+    struct pair_result {
+        std::atomic<size_t> compared{0}, skipped{0}, mismatches{0};
+        std::atomic<size_t> first{SIZE_MAX};
+    };
+    std::vector<pair_result> results(policies.size() * engines.size());
+    std::filesystem::path scratch = std::filesystem::temp_directory_path() / ("interrupts_DIFF_" + std::to_string(std::random_device{}()));
+    std::filesystem::create_directories(scratch);
+    auto make_case = [&](size_t pair, size_t index){
+        size_t policy = std::find(DIFF_POLICIES.begin(), DIFF_POLICIES.end(), policies[pair / engines.size()]) - DIFF_POLICIES.begin();
+        size_t engine = std::find(DIFF_ENGINES.begin(), DIFF_ENGINES.end(), engines[pair % engines.size()]) - DIFF_ENGINES.begin();
+        diff_case c = random_case(seed, policy, engine, index);
+        c.checkpoint = (scratch / (std::to_string(pair) + "_" + std::to_string(index) + ".ckpt")).string();
+        return c;
+    };
+
+    auto started = std::chrono::steady_clock::now();
+    parallel_for(results.size() * cases, threads, [&](size_t i){
+        size_t pair = i / cases, index = i % cases;
+        pair_result &result = results[pair];
+        switch (compare(make_case(pair, index), engines[pair % engines.size()])) {
+            case SKIPPED:   result.skipped++; break;
+            case SAME:      result.compared++; break;
+            case DIFFERENT:
+                result.compared++;
+                result.mismatches++;
+                for (size_t first = result.first; index < first && !result.first.compare_exchange_weak(first, index);) {}
+                break;
+        }
+    });
+
+    std::vector<size_t> failing;
+    for (size_t pair = 0; pair < results.size(); pair++) {
+        if (results[pair].mismatches > 0) failing.push_back(pair);
+    }
+    std::vector<std::string> reproducers(failing.size());
+    bool written = true;
+    if (!failing.empty()) std::filesystem::create_directories(output_dir);
+    parallel_for(failing.size(), threads, [&](size_t f){
+        size_t pair = failing[f], index = results[pair].first;
+        const std::string &engine = engines[pair % engines.size()];
+        diff_case minimal = shrink(make_case(pair, index), engine);
+        std::string detail;
+        if (compare(minimal, engine, &detail) != DIFFERENT) detail = "(did not reproduce after shrinking)";
+        std::string name = minimal.policy + "_" + engine + "_" + std::to_string(index);
+        if (!write_reproducer(minimal, engine, detail, output_dir, name)) written = false;
+        reproducers[f] = (output_dir / (name + ".cmd")).string() + ", " + std::to_string(minimal.workload.size()) + " process(es): " + detail;
+    });
+    std::filesystem::remove_all(scratch);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - started).count();
+
+    std::cout << std::left << std::setw(10) << "Policy" << std::setw(10) << "Engine" << std::right << std::setw(10) << "Compared"
+              << std::setw(10) << "Skipped" << std::setw(12) << "Mismatches" << std::endl;
+    for (size_t pair = 0; pair < results.size(); pair++) {
+        std::cout << std::left << std::setw(10) << policies[pair / engines.size()] << std::setw(10) << engines[pair % engines.size()]
+                  << std::right << std::setw(10) << results[pair].compared << std::setw(10) << results[pair].skipped
+                  << std::setw(12) << results[pair].mismatches << std::endl;
+    }
+    for (auto &reproducer : reproducers) std::cout << "Reproducer: " << reproducer << std::endl;
+    std::cout << results.size() * cases << " case(s) in " << std::fixed << std::setprecision(1) << seconds << " s on "
+              << threads << " thread(s), " << failing.size() << " (policy, engine) pair(s) with mismatches" << std::endl;
+    return failing.empty() && written ? 0 : 1;
+}
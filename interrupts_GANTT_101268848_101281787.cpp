@@ -0,0 +1,71 @@
+#include "interrupts_101268848_101281787.hpp"
+
+// Draws the execution table of a run as Gantt charts: <prefix>.svg and <prefix>.txt (ASCII), prefix gantt by
+// default. The table is read once, row by row, into gantt_chart grids of a fixed size, so a trace of millions of
+// transitions costs no more memory or output than a short one, only the time to read it.
+// --width=<px> (default 1200) and --rows=<n> (default 200) size the SVG, --text-width=<columns> (default 120) and
+// --text-rows=<n> (default 60) the ASCII chart; past them, columns cover more ms and rows more processes.
+
+const size_t GANTT_DEFAULT_WIDTH = 1200;
+const size_t GANTT_DEFAULT_ROWS = 200;
+const size_t GANTT_DEFAULT_TEXT_WIDTH = 120;
+const size_t GANTT_DEFAULT_TEXT_ROWS = 60;
+
+int main(int argc, char** argv) {
+    size_t sizes[] = {GANTT_DEFAULT_WIDTH, GANTT_DEFAULT_ROWS, GANTT_DEFAULT_TEXT_WIDTH, GANTT_DEFAULT_TEXT_ROWS};
+    const std::string size_options[] = {"--width=", "--rows=", "--text-width=", "--text-rows="};
+    int kept = 1;
+    for (int i = 1; i < argc; i++) {
+        std::string option = argv[i];
+        bool matched = false;
+        for (int s = 0; s < 4; s++) {
+            if (option.rfind(size_options[s], 0) != 0) continue;
+            const std::string &name = size_options[s];
+            if (!parse_number(name.substr(0, name.size() - 1), option.substr(name.size()), sizes[s], 1)) return -1;
+            matched = true;
+        }
+        if (!matched) argv[kept++] = argv[i];
+    }
+    argc = kept;
+
+    if(argc < 2 || argc > 3) {
+        std::cout << "ERROR!\nExpected 1 or 2 arguments, received " << argc - 1 << std::endl;
+        std::cout << "To run the program, do: ./interrupts_GANTT <execution.txt> [output prefix]"
+                  << " [--width=<px>] [--rows=<n>] [--text-width=<columns>] [--text-rows=<n>]" << std::endl;
+        return -1;
+    }
+    std::string prefix = argc == 3 ? argv[2] : "gantt";
+
+    std::ifstream input_file(argv[1]);
+    if (!input_file.is_open()) {
+        std::cerr << "Error: Unable to open file: " << argv[1] << std::endl;
+        return -1;
+    }
+    std::vector<char> buffer(1 << 20);
+    input_file.rdbuf()->pubsetbuf(buffer.data(), buffer.size());
+
+    gantt_chart chart(sizes[0], sizes[1], sizes[2], sizes[3]);
+    size_t events = 0;
+    std::string line;
+    while (std::getline(input_file, line)) {
+        unsigned int time;
+        int PID;
+        states old_state, new_state;
+        if (!parse_exec_status(line, time, PID, old_state, new_state)) continue;
+        chart.transition(time, PID, old_state, new_state);
+        events++;
+    }
+    chart.finish();
+
+    bool written = true;
+    for (auto &output : {std::make_pair(prefix + ".svg", chart.svg()), std::make_pair(prefix + ".txt", chart.ascii())}) {
+        std::ofstream output_file(output.first);
+        output_file << output.second;
+        if (!output_file) {
+            std::cerr << "Error: unable to write " << output.first << std::endl;
+            written = false;
+        }
+    }
+    std::cout << events << " transition(s) drawn into " << prefix << ".svg and " << prefix << ".txt" << std::endl;
+    return written ? 0 : -1;
+}
@@ -0,0 +1,19 @@
+#include "interrupts_101268848_101281787.hpp"
+
+// Multi-level feedback queue scheduler, see scheduler_MLFQ
+
+int main(int argc, char** argv) {
+    simulator_options options;
+    argc = parse_simulator_options(argc, argv, options);
+    if (argc < 0) return -1;
+
+    if(argc < 2 || argc > 4) {
+        std::cout << "ERROR!\nExpected 1 to 3 arguments, received " << argc - 1 << std::endl;
+        std::cout << "To run the program, do: ./interrupts_MLFQ <your_input_file.txt> [quanta, e.g. 25,50,100] [boost_period]" << std::endl;
+        return -1;
+    }
+
+    auto simulator = make_mlfq_simulator(std::vector<std::string>(argv + 2, argv + argc), options);
+    if (!simulator) return -1;
+    return simulate_input_file(*simulator, argv[1]);
+}
@@ -0,0 +1,33 @@
+#include "interrupts_101268848_101281787.hpp"
+
+// Prints the process table of a run at any instant from the trace store written with --trace-index=<file>:
+// the processes in memory or waiting for admission, as print_PCB shows them, after every event at that time.
+// Each query reads one snapshot and the events of at most one --index-interval, so a time late in a long run
+// costs the same as an early one. Several times can be given at once.
+
+int main(int argc, char** argv) {
+    if(argc < 3) {
+        std::cout << "ERROR!\nExpected at least 2 arguments, received " << argc - 1 << std::endl;
+        std::cout << "To run the program, do: ./interrupts_QUERY <trace store> <time> [time ...]" << std::endl;
+        return -1;
+    }
+
+    std::vector<unsigned int> times(argc - 2);
+    for (int i = 2; i < argc; i++) {
+        if (!parse_number("time", argv[i], times[i - 2])) return -1;
+    }
+
+    trace_store_reader store;
+    if (!store.open(argv[1])) return -1;
+
+    for (unsigned int time : times) {
+        size_t terminated;
+        std::vector<PCB> table = store.table_at(time, terminated);
+        size_t pending = std::count_if(table.begin(), table.end(), [](const PCB &p){ return p.state == NOT_ASSIGNED; });
+        std::cout << "At " << time << " ms" << (time > store.end_time() ? " (after the end of the run at " + std::to_string(store.end_time()) + " ms)" : "")
+                  << ": " << table.size() - pending << " admitted, " << pending << " waiting for admission, "
+                  << terminated << " terminated" << std::endl;
+        std::cout << print_PCB(table);
+    }
+    return 0;
+}
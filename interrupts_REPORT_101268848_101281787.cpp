@@ -0,0 +1,297 @@
+#include "interrupts_101268848_101281787.hpp"
+
+// Compares the scheduling policies over the traces testcases.sh (or a batch) leaves behind: every
+// <workload>_<POLICY>.txt execution table in the trace directory whose <workload>.txt is in the input directory.
+// POLICY is the rest of the file name, in upper case (EP, EP_RR, SJF, ...), so the _metrics.txt and other outputs
+// next to the traces are not taken for traces. Each trace is read once, line by line, through the accounting of
+// metrics.txt, and the traces are spread over a pool of threads (default one per core); a worker only holds the
+// totals of the trace it reads, so the pool runs as fast as the disk delivers the files.
+// Writes <prefix>.txt (default report.txt): a table per workload with a column per policy, then the same over all
+// the workloads; <prefix>.csv: the aggregate metrics of every trace, one line each; and <prefix>_processes.csv:
+// the metrics of every process in every trace.
+
+const std::string REPORT_CSV_HEADER = "workload,policy,processes,terminated,makespan,avg_turnaround,p50_turnaround,"
+                                      "p99_turnaround,avg_response,p99_response,avg_waiting,avg_admission,"
+                                      "cpu_utilization,throughput,context_switches,deadline_misses";
+const std::string REPORT_PROCESS_CSV_HEADER = "workload,policy,PID,arrival,finish,turnaround,response,admission,"
+                                              "ready,cpu,io,suspended";
+
+struct report_trace {
+    std::filesystem::path   path;
+    size_t                  workload;   // in the workload names
+    std::string             policy;
+};
+
+//The totals of one trace, or of several merged; averages are over the terminated processes
+struct trace_summary {
+    bool            read = false;
+    size_t          traces = 0;
+    size_t          processes = 0;
+    size_t          terminated = 0;
+    size_t          context_switches = 0;   // transitions to RUNNING
+    size_t          deadline_misses = 0;
+    uint64_t        makespan = 0;           // summed when merged
+    double          turnaround = 0, response = 0, ready = 0, admission = 0, cpu = 0;
+    latency_report  latency;
+    std::string     process_rows;           // <prefix>_processes.csv lines, not merged
+
+    void merge(const trace_summary &other) {
+        read = read || other.read;
+        traces += other.traces;
+        processes += other.processes;
+        terminated += other.terminated;
+        context_switches += other.context_switches;
+        deadline_misses += other.deadline_misses;
+        makespan += other.makespan;
+        turnaround += other.turnaround;
+        response += other.response;
+        ready += other.ready;
+        admission += other.admission;
+        cpu += other.cpu;
+        latency.merge(other.latency);
+    }
+
+    double average(double total) const { return terminated ? total / terminated : 0; }
+    double utilization() const { return makespan ? 100.0 * cpu / makespan : 0; }
+    double throughput() const { return makespan ? 1000.0 * terminated / makespan : 0; }
+};
+
+//Policy of the trace file name "<workload>_<POLICY>", the longest workload that fits; false if it is no trace
+bool trace_policy(const std::string &stem, const std::unordered_map<std::string, size_t> &workloads, report_trace &trace) {
+    for (size_t cut = stem.rfind('_'); cut != std::string::npos && cut > 0; cut = stem.rfind('_', cut - 1)) {
+        auto workload = workloads.find(stem.substr(0, cut));
+        if (workload == workloads.end()) continue;
+        std::string policy = stem.substr(cut + 1);
+        bool upper = !policy.empty() && std::all_of(policy.begin(), policy.end(), [](char c){ return std::isupper((unsigned char)c) || std::isdigit((unsigned char)c) || c == '_'; });
+        if (!upper) return false;
+        trace.workload = workload->second;
+        trace.policy = policy;
+        return true;
+    }
+    return false;
+}
+
+//Streams the execution table of trace; false (after printing an error) if it cannot be read
+bool summarize_trace(const report_trace &trace, const std::string &workload_name, const std::vector<PCB> &workload, trace_summary &summary) {
+    std::ifstream input_file(trace.path);
+    if (!input_file.is_open()) {
+        std::cerr << "Error: Unable to open file: " << trace.path.string() << std::endl;
+        return false;
+    }
+    std::vector<char> buffer(1 << 20);
+    input_file.rdbuf()->pubsetbuf(buffer.data(), buffer.size());
+
+    std::vector<process_metrics> metrics;
+    std::unordered_map<int, size_t> index_of;
+    for (const auto &p : workload) {
+        index_of[p.PID] = metrics.size();
+        metrics.push_back(init_metrics(p));
+    }
+
+    std::string line;
+    while (std::getline(input_file, line)) {
+        unsigned int time;
+        int PID;
+        states old_state, new_state;
+        if (!parse_exec_status(line, time, PID, old_state, new_state)) continue;
+        auto found = index_of.find(PID);
+        if (found == index_of.end()) continue;
+        track_transition(metrics[found->second], time, new_state);
+        if (new_state == RUNNING) summary.context_switches++;
+        summary.makespan = std::max<uint64_t>(summary.makespan, time);
+    }
+
+    std::ostringstream rows;
+    summary.read = true;
+    summary.traces = 1;
+    summary.processes = metrics.size();
+    summary.latency = latency_from_metrics(metrics);
+    for (const auto &m : metrics) {
+        rows << workload_name << "," << trace.policy << "," << m.PID << "," << m.arrival_time << "," << m.finish_time << ","
+             << (m.finish_time < 0 ? -1 : m.finish_time - (int)m.arrival_time) << "," << m.response_time << ","
+             << m.admission_time << "," << m.ready_time << "," << m.cpu_time << "," << m.io_time << "," << m.suspended_time << "\n";
+        summary.cpu += m.cpu_time;
+        if (m.finish_time < 0) continue;
+        summary.terminated++;
+        summary.turnaround += m.finish_time - m.arrival_time;
+        summary.response += m.response_time;
+        summary.ready += m.ready_time;
+        summary.admission += m.admission_time;
+        if (m.deadline > 0 && (unsigned int)m.finish_time > m.deadline) summary.deadline_misses++;
+    }
+    summary.process_rows = rows.str();
+    return true;
+}
+
+//Side-by-side table of the summaries, a column per policy ("-" where a policy has no trace)
+std::string print_comparison(const std::string &title, const std::vector<std::string> &policies, const std::vector<const trace_summary*> &columns,
+                             const std::vector<size_t> *best = nullptr) {
+    const int label_width = 22;
+    std::vector<int> widths;
+    for (auto &policy : policies) widths.push_back(std::max<int>(10, policy.size() + 1));
+    int tableWidth = label_width + 2;
+    for (int w : widths) tableWidth += w + 2;
+
+    using row_value = std::function<std::string(const trace_summary&)>;
+    auto fixed = [](double value){
+        std::ostringstream text;
+        text << std::fixed << std::setprecision(2) << value;
+        return text.str();
+    };
+    const std::vector<std::pair<std::string, row_value>> rows = {
+        {"Processes",           [](const trace_summary &s){ return std::to_string(s.processes); }},
+        {"Terminated",          [](const trace_summary &s){ return std::to_string(s.terminated); }},
+        {"Makespan (ms)",       [](const trace_summary &s){ return std::to_string(s.makespan); }},
+        {"Avg turnaround",      [&](const trace_summary &s){ return fixed(s.average(s.turnaround)); }},
+        {"p99 turnaround",      [](const trace_summary &s){ return std::to_string(s.latency.turnaround.value_at(99)); }},
+        {"Avg response",        [&](const trace_summary &s){ return fixed(s.average(s.response)); }},
+        {"p99 response",        [](const trace_summary &s){ return std::to_string(s.latency.response.value_at(99)); }},
+        {"Avg waiting (ready)", [&](const trace_summary &s){ return fixed(s.average(s.ready)); }},
+        {"Avg admission",       [&](const trace_summary &s){ return fixed(s.average(s.admission)); }},
+        {"CPU utilization %",   [&](const trace_summary &s){ return fixed(s.utilization()); }},
+        {"Throughput (proc/s)", [&](const trace_summary &s){ return fixed(s.throughput()); }},
+        {"Context switches",    [](const trace_summary &s){ return std::to_string(s.context_switches); }},
+        {"Deadline misses",     [](const trace_summary &s){ return std::to_string(s.deadline_misses); }},
+    };
+
+    std::stringstream buffer;
+    buffer << title << std::endl;
+    buffer << "+" << std::setfill('-') << std::setw(tableWidth) << "+" << std::endl;
+    buffer << "|" << std::setfill(' ') << std::setw(label_width) << "Metric";
+    for (size_t p = 0; p < policies.size(); p++) buffer << std::setw(2) << "|" << std::setw(widths[p]) << policies[p];
+    buffer << std::setw(2) << "|" << std::endl;
+    buffer << "+" << std::setfill('-') << std::setw(tableWidth) << "+" << std::endl;
+    for (auto &row : rows) {
+        buffer << "|" << std::setfill(' ') << std::setw(label_width) << row.first;
+        for (size_t p = 0; p < policies.size(); p++) {
+            buffer << std::setw(2) << "|" << std::setw(widths[p]) << (columns[p] && columns[p]->read ? row.second(*columns[p]) : "-");
+        }
+        buffer << std::setw(2) << "|" << std::endl;
+    }
+    if (best) {
+        buffer << "|" << std::setfill(' ') << std::setw(label_width) << "Best avg turnaround";
+        for (size_t p = 0; p < policies.size(); p++) buffer << std::setw(2) << "|" << std::setw(widths[p]) << (*best)[p];
+        buffer << std::setw(2) << "|" << std::endl;
+    }
+    buffer << "+" << std::setfill('-') << std::setw(tableWidth) << "+" << std::endl;
+    return buffer.str();
+}
+
+int main(int argc, char** argv) {
+    if(argc < 3 || argc > 5) {
+        std::cout << "ERROR!\nExpected 2 to 4 arguments, received " << argc - 1 << std::endl;
+        std::cout << "To run the program, do: ./interrupts_REPORT <input_dir> <trace_dir> [report prefix] [threads]" << std::endl;
+        return -1;
+    }
+    std::string prefix = argc >= 4 ? argv[3] : "report";
+    unsigned int threads = std::thread::hardware_concurrency();
+    if (argc == 5 && !parse_number("threads", argv[4], threads, 1)) return -1;
+
+    std::vector<std::string> workload_names;
+    std::unordered_map<std::string, size_t> workload_index;
+    std::vector<report_trace> traces;
+    try {
+        for (auto &entry : std::filesystem::directory_iterator(argv[1])) {
+            if (entry.path().extension() != ".txt") continue;
+            workload_names.push_back(entry.path().stem().string());
+        }
+        std::sort(workload_names.begin(), workload_names.end());
+        for (size_t w = 0; w < workload_names.size(); w++) workload_index[workload_names[w]] = w;
+
+        for (auto &entry : std::filesystem::directory_iterator(argv[2])) {
+            report_trace trace;
+            trace.path = entry.path();
+            if (entry.is_regular_file() && trace.path.extension() == ".txt" && trace_policy(trace.path.stem().string(), workload_index, trace)) traces.push_back(trace);
+        }
+    } catch (const std::filesystem::filesystem_error &e) {
+        std::cerr << "Error: " << e.what() << std::endl;
+        return -1;
+    }
+    if (traces.empty()) {
+        std::cerr << "Error: no <workload>_<POLICY>.txt trace in " << argv[2] << " matches a workload in " << argv[1] << std::endl;
+        return -1;
+    }
+    std::sort(traces.begin(), traces.end(), [](const report_trace &a, const report_trace &b){ return a.path < b.path; });
+
+    threads = std::max(1u, std::min<unsigned int>(threads, traces.size()));
+
+    // the workloads with traces first, then every trace against its workload
+    std::vector<bool> used(workload_names.size(), false);
+    for (auto &trace : traces) used[trace.workload] = true;
+    std::vector<std::vector<PCB>> workloads(workload_names.size());
+    std::vector<char> workload_read(workload_names.size(), false);
+    parallel_for(workload_names.size(), threads, [&](size_t w){
+        if (used[w]) workload_read[w] = read_workload((std::filesystem::path(argv[1]) / (workload_names[w] + ".txt")).string(), workloads[w]);
+    });
+    std::vector<trace_summary> summaries(traces.size());
+    parallel_for(traces.size(), threads, [&](size_t t){
+        size_t w = traces[t].workload;
+        if (workload_read[w]) summarize_trace(traces[t], workload_names[w], workloads[w], summaries[t]);
+    });
+
+    std::vector<std::string> policies;
+    for (auto &trace : traces) {
+        if (std::find(policies.begin(), policies.end(), trace.policy) == policies.end()) policies.push_back(trace.policy);
+    }
+    std::sort(policies.begin(), policies.end());
+    auto policy_column = [&](const std::string &policy){ return std::find(policies.begin(), policies.end(), policy) - policies.begin(); };
+
+    // per workload, the traces by policy; over all of them, the merged summaries and how often a policy was best
+    std::vector<std::vector<const trace_summary*>> by_workload(workload_names.size(), std::vector<const trace_summary*>(policies.size(), nullptr));
+    std::vector<trace_summary> overall(policies.size());
+    std::vector<size_t> best(policies.size(), 0);
+    bool any_failed = false;
+    for (size_t t = 0; t < traces.size(); t++) {
+        if (!summaries[t].read) {
+            any_failed = true;
+            continue;
+        }
+        size_t p = policy_column(traces[t].policy);
+        by_workload[traces[t].workload][p] = &summaries[t];
+        overall[p].merge(summaries[t]);
+    }
+
+    std::ostringstream table, csv, process_csv;
+    csv << REPORT_CSV_HEADER << "\n";
+    process_csv << REPORT_PROCESS_CSV_HEADER << "\n";
+    size_t compared = 0;
+    for (size_t w = 0; w < workload_names.size(); w++) {
+        auto &columns = by_workload[w];
+        if (std::none_of(columns.begin(), columns.end(), [](const trace_summary *s){ return s != nullptr; })) continue;
+        compared++;
+        double lowest = -1;
+        for (auto s : columns) {
+            if (s && s->terminated && (lowest < 0 || s->average(s->turnaround) < lowest)) lowest = s->average(s->turnaround);
+        }
+        for (size_t p = 0; p < policies.size(); p++) {
+            if (columns[p] && columns[p]->terminated && columns[p]->average(columns[p]->turnaround) == lowest) best[p]++;
+        }
+        table << print_comparison(workload_names[w], policies, columns) << std::endl;
+    }
+    for (size_t t = 0; t < traces.size(); t++) {
+        const trace_summary &s = summaries[t];
+        if (!s.read) continue;
+        csv << workload_names[traces[t].workload] << "," << traces[t].policy << "," << s.processes << "," << s.terminated << ","
+            << s.makespan << "," << std::fixed << std::setprecision(2) << s.average(s.turnaround) << ","
+            << s.latency.turnaround.value_at(50) << "," << s.latency.turnaround.value_at(99) << "," << s.average(s.response) << ","
+            << s.latency.response.value_at(99) << "," << s.average(s.ready) << "," << s.average(s.admission) << ","
+            << s.utilization() << "," << s.throughput() << "," << s.context_switches << "," << s.deadline_misses << "\n";
+        process_csv << s.process_rows;
+    }
+    std::vector<const trace_summary*> overall_columns;
+    for (auto &s : overall) overall_columns.push_back(&s);
+    table << print_comparison("All " + std::to_string(compared) + " workload(s), makespans summed", policies, overall_columns, &best);
+
+    for (auto &output : {std::make_pair(prefix + ".txt", table.str()), std::make_pair(prefix + ".csv", csv.str()),
+                         std::make_pair(prefix + "_processes.csv", process_csv.str())}) {
+        std::ofstream output_file(output.first);
+        output_file << output.second;
+        if (!output_file) {
+            std::cerr << "Error: unable to write " << output.first << std::endl;
+            any_failed = true;
+        }
+    }
+    std::cout << traces.size() << " trace(s) of " << compared << " workload(s) under " << policies.size() << " policies compared into "
+              << prefix << ".txt, " << prefix << ".csv and " << prefix << "_processes.csv" << std::endl;
+    return any_failed ? 1 : 0;
+}
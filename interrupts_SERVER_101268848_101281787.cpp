@@ -0,0 +1,232 @@
+#include "interrupts_101268848_101281787.hpp"
+#include <cerrno>
+#include <csignal>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+// Long-running simulator: takes workloads over stdin/stdout, or over a Unix domain socket with --socket=<path>,
+// and sends the outputs back inline, so a caller running many small workloads pays process startup once.
+// Requests are served one at a time, and a socket serves one connection after the other.
+//
+// Request: run <outputs> <bytes> <POLICY> [policy arguments] [simulator options]\n<bytes of workload>
+//          <outputs> is a comma-separated list of execution, metrics, memory, devices, what-if, latency (the
+//          histograms of latency_report::write, to merge over requests) and samples (with --sample-interval),
+//          the workload is in the input file format and the options are those of the single-run binaries.
+//          quit\n ends the session.
+// Reply:   ok <status> <count>\n then <count> times <output> <bytes>\n<bytes of content>, status as the exit
+//          code of a single run (0, or 1 if the watchdog stopped it), or
+//          error <bytes>\n<bytes of message>, with everything the run printed on std::cerr.
+// The simulator of every (policy, arguments, options) seen is kept warm and reloaded for the next request, and
+// a request with --cache=<dir> goes through the result cache like the single-run binaries.
+
+const size_t SERVER_WARM_SIMULATORS = 32;
+const std::vector<std::string> SERVER_OUTPUTS = {"execution", "metrics", "memory", "devices", "what-if", "latency", "samples"};
+
+//Buffered framing on a pair of file descriptors (stdin/stdout, or both ends of a socket)
+class frame_stream {
+public:
+    frame_stream(int input, int output) : input(input), output(output) {}
+
+    //The next line without its '\n'; false at the end of the input
+    bool read_line(std::string &line) {
+        line.clear();
+        for (;;) {
+            char *newline = (char*)memchr(buffer + start, '\n', end - start);
+            if (newline) {
+                line.append(buffer + start, newline);
+                start = newline - buffer + 1;
+                return true;
+            }
+            line.append(buffer + start, buffer + end);
+            start = end;
+            if (!fill()) return false;
+        }
+    }
+
+    bool read_bytes(size_t count, std::string &bytes) {
+        bytes.clear();
+        while (bytes.size() < count) {
+            if (start == end && !fill()) return false;
+            size_t take = std::min(count - bytes.size(), end - start);
+            bytes.append(buffer + start, take);
+            start += take;
+        }
+        return true;
+    }
+
+    bool write(const std::string &bytes) {
+        for (size_t sent = 0; sent < bytes.size();) {
+            ssize_t n = ::write(output, bytes.data() + sent, bytes.size() - sent);
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) return false;
+            sent += n;
+        }
+        return true;
+    }
+
+private:
+    bool fill() {
+        ssize_t n;
+        do n = ::read(input, buffer, sizeof(buffer)); while (n < 0 && errno == EINTR);
+        if (n <= 0) return false;
+        start = 0;
+        end = n;
+        return true;
+    }
+
+    int input, output;
+    char buffer[1 << 16];
+    size_t start = 0, end = 0;
+};
+
+//Everything written to std::cerr while it lives goes into text instead
+struct cerr_capture {
+    std::ostringstream text;
+    std::streambuf *saved;
+    cerr_capture() : saved(std::cerr.rdbuf(text.rdbuf())) {}
+    ~cerr_capture() { std::cerr.rdbuf(saved); }
+};
+
+std::string error_reply(const std::string &message) {
+    return "error " + std::to_string(message.size()) + "\n" + message;
+}
+
+class simulation_server {
+public:
+    //Serves requests until quit or the end of the input; false if the connection broke
+    bool serve(frame_stream &stream) {
+        std::string header, workload;
+        while (stream.read_line(header)) {
+            std::istringstream fields(header);
+            std::string verb, outputs;
+            size_t bytes = 0;
+            fields >> verb;
+            if (verb == "quit") return true;
+            if (verb != "run" || !(fields >> outputs >> bytes)) {
+                // the workload that may follow cannot be told apart from the next request, so give up on the session
+                stream.write(error_reply("Error: expected \"run <outputs> <bytes> <POLICY> ...\" or \"quit\", got \"" + header + "\"\n"));
+                return false;
+            }
+            if (!stream.read_bytes(bytes, workload)) return false;
+
+            std::vector<std::string> arguments;
+            for (std::string argument; fields >> argument;) arguments.push_back(argument);
+            if (!stream.write(run(split_delim(outputs, ","), arguments, workload))) return false;
+        }
+        return true;
+    }
+
+private:
+    std::string run(const std::vector<std::string> &outputs, const std::vector<std::string> &arguments, const std::string &workload) {
+        cerr_capture errors;
+        try {
+            for (auto &output : outputs) {
+                if (std::find(SERVER_OUTPUTS.begin(), SERVER_OUTPUTS.end(), output) == SERVER_OUTPUTS.end()) {
+                    std::cerr << "Error: unknown output " << output << ", expected execution, metrics, memory, devices, what-if, latency or samples" << std::endl;
+                }
+            }
+            Simulator *simulator = errors.text.str().empty() ? warm_simulator(arguments) : nullptr;
+            if (!simulator) return error_reply(errors.text.str());
+
+            std::istringstream input(workload);
+            std::vector<PCB> list_process;
+            read_workload(input, list_process);
+            if (!simulator->admission_feasible(list_process)) return error_reply(errors.text.str());
+            cached_result result;
+            int status = run_cached(*simulator, list_process, result);
+            if (status < 0) return error_reply(errors.text.str());
+
+            std::string reply = "ok " + std::to_string(status) + " " + std::to_string(outputs.size()) + "\n";
+            for (auto &output : outputs) {
+                const std::string &content = output == "execution" ? result.execution : output == "metrics" ? result.metrics :
+                                             output == "memory" ? result.memory : output == "devices" ? result.devices :
+                                             output == "what-if" ? result.what_if : output == "latency" ? result.latency :
+                                             result.samples;
+                reply += output + " " + std::to_string(content.size()) + "\n" + content;
+            }
+            return reply;
+        } catch (const std::exception &e) {
+            // a malformed number in the options or the workload
+            return error_reply(errors.text.str() + "Error: bad request (" + e.what() + ")\n");
+        }
+    }
+
+    //The simulator for POLICY [arguments] [options], made on first use
+    Simulator *warm_simulator(const std::vector<std::string> &arguments) {
+        std::string key;
+        for (auto &argument : arguments) key += argument + " ";
+        auto warm = simulators.find(key);
+        if (warm != simulators.end()) return warm->second.get();
+
+        std::vector<std::string> argv_text = {"interrupts_SERVER"};
+        argv_text.insert(argv_text.end(), arguments.begin(), arguments.end());
+        std::vector<char*> argv;
+        for (auto &argument : argv_text) argv.push_back(&argument[0]);
+        simulator_options options;
+        int argc = parse_simulator_options(argv.size(), argv.data(), options);
+        if (argc < 0) return nullptr;
+        if (argc < 2) {
+            std::cerr << "Error: the request names no policy" << std::endl;
+            return nullptr;
+        }
+        if (!options.checkpoint_path.empty() || !options.resume_path.empty() || !options.trace_index_path.empty()) {
+            std::cerr << "Error: --checkpoint, --resume and --trace-index write files and cannot be used with the server" << std::endl;
+            return nullptr;
+        }
+        auto simulator = make_simulator(argv[1], std::vector<std::string>(argv.begin() + 2, argv.begin() + argc), options);
+        if (!simulator) return nullptr;
+
+        if (simulators.size() >= SERVER_WARM_SIMULATORS) simulators.clear();
+        return (simulators[key] = std::move(simulator)).get();
+    }
+
+    std::unordered_map<std::string, std::unique_ptr<Simulator>> simulators;
+};
+
+int serve_socket(simulation_server &server, const std::string &path) {
+    sockaddr_un address{};
+    address.sun_family = AF_UNIX;
+    if (path.size() >= sizeof(address.sun_path)) {
+        std::cerr << "Error: socket path " << path << " is too long" << std::endl;
+        return -1;
+    }
+    std::strcpy(address.sun_path, path.c_str());
+
+    int listener = socket(AF_UNIX, SOCK_STREAM, 0);
+    unlink(path.c_str());
+    if (listener < 0 || bind(listener, (sockaddr*)&address, sizeof(address)) < 0 || listen(listener, 16) < 0) {
+        std::cerr << "Error: unable to listen on " << path << ": " << std::strerror(errno) << std::endl;
+        return -1;
+    }
+    for (;;) {
+        int client = accept(listener, nullptr, nullptr);
+        if (client < 0) {
+            if (errno == EINTR) continue;
+            std::cerr << "Error: accept failed on " << path << ": " << std::strerror(errno) << std::endl;
+            break;
+        }
+        frame_stream stream(client, client);
+        server.serve(stream);
+        close(client);
+    }
+    close(listener);
+    unlink(path.c_str());
+    return -1;
+}
+
+int main(int argc, char** argv) {
+    std::string socket_path;
+    if (argc == 2 && std::string(argv[1]).rfind("--socket=", 0) == 0) socket_path = std::string(argv[1]).substr(9);
+    else if (argc != 1) {
+        std::cout << "ERROR!\nExpected 0 or 1 arguments, received " << argc - 1 << std::endl;
+        std::cout << "To run the program, do: ./interrupts_SERVER [--socket=<path>]" << std::endl;
+        return -1;
+    }
+    signal(SIGPIPE, SIG_IGN);   // a client that goes away is a failed write, not the end of the server
+
+    simulation_server server;
+    if (!socket_path.empty()) return serve_socket(server, socket_path);
+    frame_stream stream(STDIN_FILENO, STDOUT_FILENO);
+    return server.serve(stream) ? 0 : 1;
+}
@@ -0,0 +1,19 @@
+#include "interrupts_101268848_101281787.hpp"
+
+// Shortest-Remaining-Time-First / Shortest-Job-First scheduler, see scheduler_SRTF
+
+int main(int argc, char** argv) {
+    simulator_options options;
+    argc = parse_simulator_options(argc, argv, options);
+    if (argc < 0) return -1;
+
+    if(argc < 2 || argc > 3) {
+        std::cout << "ERROR!\nExpected 1 or 2 arguments, received " << argc - 1 << std::endl;
+        std::cout << "To run the program, do: ./interrupts_SRTF <your_input_file.txt> [srtf|sjf]" << std::endl;
+        return -1;
+    }
+
+    auto simulator = make_srtf_simulator(std::vector<std::string>(argv + 2, argv + argc), options);
+    if (!simulator) return -1;
+    return simulate_input_file(*simulator, argv[1]);
+}
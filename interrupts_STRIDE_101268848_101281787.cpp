@@ -0,0 +1,19 @@
+#include "interrupts_101268848_101281787.hpp"
+
+// Stride and lottery proportional-share schedulers, see scheduler_STRIDE
+
+int main(int argc, char** argv) {
+    simulator_options options;
+    argc = parse_simulator_options(argc, argv, options);
+    if (argc < 0) return -1;
+
+    if(argc < 2 || argc > 5) {
+        std::cout << "ERROR!\nExpected 1 to 4 arguments, received " << argc - 1 << std::endl;
+        std::cout << "To run the program, do: ./interrupts_STRIDE <your_input_file.txt> [stride|lottery] [quantum] [seed]" << std::endl;
+        return -1;
+    }
+
+    auto simulator = make_stride_simulator(std::vector<std::string>(argv + 2, argv + argc), options);
+    if (!simulator) return -1;
+    return simulate_input_file(*simulator, argv[1]);
+}
@@ -0,0 +1,104 @@
+#include "interrupts_101268848_101281787.hpp"
+#include <mutex>
+
+// Throughput of the rings the simulator uses between threads, and a check that they lose, duplicate or reorder
+// nothing. Every item carries its producer and sequence number; the consumer verifies each producer's items
+// arrive exactly once and in order. Build with -fsanitize=thread to check the rings for data races as well.
+// - spsc_ring: 1 producer, 1 consumer
+// - mpsc_ring: 1 to 64 producers, 1 consumer, against a std::mutex + std::queue baseline
+// Exits with 1 if a check fails.
+
+const size_t BENCH_DEFAULT_ITEMS = 1 << 21;     // per run, split between the producers
+const size_t BENCH_RING_SIZE = 1 << 12;
+const unsigned int BENCH_PRODUCERS[] = {1, 2, 4, 8, 16, 32, 64};
+
+//The baseline: what the rings replace
+template <typename T>
+class locked_queue {
+public:
+    void push(const T &value) {
+        std::lock_guard<std::mutex> lock(mutex);
+        items.push(value);
+    }
+    bool try_pop(T &value) {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (items.empty()) return false;
+        value = items.front();
+        items.pop();
+        return true;
+    }
+
+private:
+    std::mutex mutex;
+    std::queue<T> items;
+};
+
+//Items are (producer << 32 | sequence). Returns items per second, or -1 if the consumer saw a lost,
+//duplicated or reordered item.
+template <typename Queue>
+double run_bench(Queue &queue, unsigned int producers, size_t items) {
+    size_t per_producer = items / producers;
+    std::atomic<bool> go(false);
+    std::vector<std::thread> threads;
+    for (unsigned int p = 0; p < producers; p++) {
+        threads.emplace_back([&, p](){
+            while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+            for (uint64_t i = 0; i < per_producer; i++) queue.push(((uint64_t)p << 32) | i);
+        });
+    }
+
+    std::vector<uint64_t> next(producers, 0);
+    bool ordered = true;
+    auto start = std::chrono::steady_clock::now();
+    go.store(true, std::memory_order_release);
+    for (size_t received = 0; received < per_producer * producers; received++) {
+        uint64_t item;
+        while (!queue.try_pop(item)) std::this_thread::yield();
+        unsigned int p = item >> 32;
+        if (p >= producers || (item & 0xffffffffu) != next[p]++) ordered = false;
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    for (auto &thread : threads) thread.join();
+
+    uint64_t extra;
+    if (queue.try_pop(extra)) ordered = false;
+    return ordered ? per_producer * producers / seconds : -1;
+}
+
+std::string rate(double items_per_second) {
+    std::ostringstream text;
+    if (items_per_second < 0) text << "FAILED";
+    else text << std::fixed << std::setprecision(2) << items_per_second / 1e6 << " M/s";
+    return text.str();
+}
+
+int main(int argc, char** argv) {
+    if(argc > 2) {
+        std::cout << "ERROR!\nExpected 0 or 1 arguments, received " << argc - 1 << std::endl;
+        std::cout << "To run the program, do: ./queue_bench [items]" << std::endl;
+        return -1;
+    }
+    size_t items = BENCH_DEFAULT_ITEMS;
+    if (argc == 2 && !parse_number("items", argv[1], items, 1)) return -1;
+    bool failed = false;
+
+    std::cout << "cores: " << std::thread::hardware_concurrency() << ", items per run: " << items << std::endl;
+    {
+        spsc_ring<uint64_t> ring(BENCH_RING_SIZE);
+        double spsc = run_bench(ring, 1, items);
+        failed |= spsc < 0;
+        std::cout << "spsc_ring   1 producer : " << rate(spsc) << std::endl;
+    }
+
+    std::cout << std::setw(10) << "producers" << std::setw(16) << "mpsc_ring" << std::setw(16) << "mutex queue" << std::endl;
+    for (unsigned int producers : BENCH_PRODUCERS) {
+        mpsc_ring<uint64_t> ring(BENCH_RING_SIZE);
+        locked_queue<uint64_t> locked;
+        double mpsc = run_bench(ring, producers, items);
+        double baseline = run_bench(locked, producers, items);
+        failed |= mpsc < 0 || baseline < 0;
+        std::cout << std::setw(10) << producers << std::setw(16) << rate(mpsc) << std::setw(16) << rate(baseline) << std::endl;
+    }
+
+    return failed ? 1 : 0;
+}
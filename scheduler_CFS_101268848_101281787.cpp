@@ -0,0 +1,232 @@
+#include "interrupts_101268848_101281787.hpp"
+#include <set>
+
+// CFS-style fair scheduler
+// - every process accumulates a virtual runtime: CPU time scaled by NICE_0_WEIGHT / weight(nice)
+// - READY processes live in a balanced tree (std::set, a red-black tree like the kernel's) ordered by vruntime
+// - the timeslice is target_latency * weight / total runnable weight, never below min_granularity
+// - an arrival or I/O wake-up that is min_granularity of vruntime behind the running process preempts it
+// vruntime is kept in weighted microseconds so a 1 ms tick still has precision at nice 19.
+
+const unsigned int CFS_DEFAULT_TARGET_LATENCY = 20;
+const unsigned int CFS_DEFAULT_MIN_GRANULARITY = 4;
+const uint64_t NICE_0_WEIGHT = 1024;
+
+// Linux sched_prio_to_weight[], nice -20 .. 19; each step is ~10% CPU
+const uint64_t nice_to_weight[40] = {
+    88761, 71755, 56483, 46273, 36291,
+    29154, 23254, 18705, 14949, 11916,
+     9548,  7620,  6100,  4904,  3906,
+     3121,  2501,  1991,  1586,  1277,
+     1024,   820,   655,   526,   423,
+      335,   272,   215,   172,   137,
+      110,    87,    70,    56,    45,
+       36,    29,    23,    18,    15
+};
+
+struct cfs_config {
+    unsigned int    target_latency;     // ms in which every runnable process should run once
+    unsigned int    min_granularity;    // shortest slice in ms
+};
+
+static uint64_t cfs_weight(int nice) {
+    return nice_to_weight[std::min(std::max(nice, -20), 19) + 20];
+}
+
+class cfs_simulator : public Simulator {
+public:
+    cfs_simulator(const cfs_config &config, const simulator_options &options) : Simulator(options), config(config) {}
+
+private:
+    const cfs_config config;
+
+    typedef std::pair<uint64_t, unsigned long> vruntime_key;   // (vruntime, ready sequence)
+    std::set<std::pair<vruntime_key, size_t>> ready_queue;      // leftmost is the next to run
+    unsigned long ready_sequence = 0;
+    uint64_t ready_weight = 0;                                  // total weight of READY processes
+
+    std::vector<uint64_t> vruntime;
+    uint64_t min_vruntime = 0;
+
+    io_scheduler wait_queue{io_devices, io_horizon};    // I/O and page-fault completions by index, per-device queues
+
+    std::set<size_t> pending;       // arrived but no partition yet, kept in input order
+    bool memory_freed = false;      // pending admissions can only succeed after a partition is freed
+    int running = -1;               // index of the running process, -1 when idle
+    unsigned int slice = 0;         // timeslice of the running process
+    unsigned int slice_used = 0;
+
+    std::vector<size_t> arrivals;   // arrival order (stable, so same-tick arrivals keep input order)
+    size_t next_arrival = 0;
+
+    void enqueue(size_t i) {
+        ready_queue.insert({{vruntime[i], ready_sequence++}, i});
+        ready_weight += cfs_weight(list_process[i].nice);
+    }
+
+    size_t dequeue_leftmost() {
+        size_t i = ready_queue.begin()->second;
+        ready_queue.erase(ready_queue.begin());
+        ready_weight -= cfs_weight(list_process[i].nice);
+        return i;
+    }
+
+    bool admit(size_t i) override {
+        if (!assign_memory(list_process[i], current_time)) return false;
+        vruntime[i] = min_vruntime;     // start level with the current fair clock
+        transition(current_time, i, NEW, READY);
+        enqueue(i);
+        return true;
+    }
+
+    void update_min_vruntime() {
+        uint64_t candidate = UINT64_MAX;
+        if (running != -1) candidate = vruntime[running];
+        if (!ready_queue.empty()) candidate = std::min(candidate, ready_queue.begin()->first.first);
+        if (candidate != UINT64_MAX) min_vruntime = std::max(min_vruntime, candidate);
+    }
+
+    void start() override {
+        ready_queue.clear();
+        ready_sequence = 0;
+        ready_weight = 0;
+        vruntime.assign(total_processes, 0);
+        min_vruntime = 0;
+        wait_queue = io_scheduler(io_devices, io_horizon);
+        pending.clear();
+        memory_freed = false;
+        running = -1;
+        slice = slice_used = 0;
+
+        keep_metrics();
+
+        order_arrivals(arrivals, next_arrival);
+    }
+
+    void process_added(size_t index) override {
+        vruntime.push_back(0);
+        add_arrival(arrivals, next_arrival, index);
+    }
+
+    bool stalled() const override {
+        return running == -1 && ready_queue.empty() && wait_queue.empty() && next_arrival == total_processes &&
+               !admission_possible(current_time);
+    }
+
+    // everything tick() carries from one tick to the next, for checkpoints
+    void archive_state(state_archive &ar) override {
+        archive(ar, ready_queue);
+        archive_history(ar, ready_sequence);
+        archive(ar, ready_weight);
+        archive(ar, vruntime);
+        archive(ar, min_vruntime);
+        archive(ar, wait_queue);
+        archive(ar, pending);
+        archive(ar, memory_freed);
+        archive(ar, running);
+        archive(ar, slice);
+        archive(ar, slice_used);
+        archive_arrivals(ar, arrivals, next_arrival);
+        archive_history(ar, metrics);
+    }
+
+    std::string policy_signature() const override {
+        return "CFS " + std::to_string(config.target_latency) + " " + std::to_string(config.min_granularity);
+    }
+
+    void tick() override {
+        // --- arrivals at this tick ---
+        admit_arrivals(arrivals, next_arrival, pending);
+
+        // Retry to assign memory for earlier arrivals that couldn't fit
+        retry_pending(pending, memory_freed);
+
+        // --- handle I/O completions scheduled for this tick ---
+        size_t i;
+        while (wait_queue.next_completion(current_time, i)) {
+            // sleeper credit of half a target latency, but no more
+            uint64_t floor = min_vruntime > 500 * config.target_latency ? min_vruntime - 500 * config.target_latency : 0;
+            vruntime[i] = std::max(vruntime[i], floor);
+            transition(current_time, i, WAITING, READY);
+            enqueue(i);
+        }
+
+        // --- wake-up preemption ---
+        if (running != -1 && !ready_queue.empty()) {
+            uint64_t leftmost = ready_queue.begin()->first.first;
+            if (leftmost + 1000 * config.min_granularity < vruntime[running]) {
+                transition(current_time, running, RUNNING, READY);
+                enqueue(running);
+                running = -1;
+            }
+        }
+
+        // --- Scheduler dispatch if CPU idle ---
+        if (running == -1 && !ready_queue.empty()) {
+            uint64_t total_weight = ready_weight;
+            running = dequeue_leftmost();
+            uint64_t weight = cfs_weight(list_process[running].nice);
+            // the period stretches when there are more processes than target_latency / min_granularity
+            uint64_t runnable = ready_queue.size() + 1;
+            uint64_t period = std::max<uint64_t>(config.target_latency, runnable * config.min_granularity);
+            slice = std::max<uint64_t>(config.min_granularity, period * weight / total_weight);
+            slice_used = 0;
+            list_process[running].start_time = current_time;
+            transition(current_time, running, READY, RUNNING);
+        }
+
+        // --- page fault: this ms is spent trapping, the process waits for the page ---
+        // the trap is charged like CPU time: a process that faults on every dispatch would otherwise stay leftmost
+        // and, when no frame can be taken, keep the owners of the pinned frames from ever running
+        if (running != -1 && page_fault(list_process[running], current_time)) {
+            vruntime[running] += 1000 * NICE_0_WEIGHT / cfs_weight(list_process[running].nice);
+            update_min_vruntime();
+            transition(current_time + 1, running, RUNNING, WAITING);
+            wait_queue.submit(current_time + 1, -1, options.page_fault_time, running, list_process[running].PID);
+            running = -1;
+        }
+
+        // --- Execute one ms of CPU if running ---
+        if (running != -1) {
+            PCB &p = list_process[running];
+            p.remaining_time--;
+            slice_used++;
+            vruntime[running] += 1000 * NICE_0_WEIGHT / cfs_weight(p.nice);
+            update_min_vruntime();
+
+            unsigned int executed_time = p.processing_time - p.remaining_time;
+            unsigned int transition_time = current_time + 1;
+
+            if (p.io_freq > 0 && executed_time > 0 && (executed_time % p.io_freq) == 0 && p.remaining_time > 0) {
+                transition(transition_time, running, RUNNING, WAITING);
+                wait_queue.submit(transition_time, p.device, p.io_duration, running, p.PID);
+                running = -1;
+            } else if (p.remaining_time == 0) {
+                transition(transition_time, running, RUNNING, TERMINATED);
+                free_memory(p, transition_time);
+                memory_freed = true;
+                terminated_count++;
+                running = -1;
+            } else if (slice_used >= slice && !ready_queue.empty()) {
+                // slice used up and someone else is runnable
+                transition(transition_time, running, RUNNING, READY);
+                enqueue(running);
+                running = -1;
+            }
+        }
+    }
+};
+
+std::unique_ptr<Simulator> make_cfs_simulator(const std::vector<std::string> &args, const simulator_options &options) {
+    if (args.size() > 2) {
+        std::cerr << "Error: CFS takes at most 2 arguments: [target_latency] [min_granularity]" << std::endl;
+        return nullptr;
+    }
+
+    if (!swapping_supported("CFS", options)) return nullptr;
+
+    cfs_config config = {CFS_DEFAULT_TARGET_LATENCY, CFS_DEFAULT_MIN_GRANULARITY};
+    if (args.size() >= 1 && !parse_number("CFS target_latency", args[0], config.target_latency, 1)) return nullptr;
+    if (args.size() == 2 && !parse_number("CFS min_granularity", args[1], config.min_granularity, 1)) return nullptr;
+    return std::make_unique<cfs_simulator>(config, options);
+}
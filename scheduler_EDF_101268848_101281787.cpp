@@ -0,0 +1,155 @@
+#include "interrupts_101268848_101281787.hpp"
+#include <set>
+
+// Earliest-Deadline-First real-time scheduler
+// - absolute deadline = arrival time + the optional deadline column; processes without one run last
+// - READY processes are kept in an indexed_heap ordered by absolute deadline (FCFS among equal deadlines)
+// - a process becoming ready with a strictly earlier deadline preempts the running one immediately,
+//   the same way a higher priority preempts in the EP+RR scheduler
+// metrics.txt reports deadline misses, the lateness distribution and the maximum tardiness.
+
+const unsigned int NO_DEADLINE = UINT32_MAX;
+
+class edf_simulator : public Simulator {
+public:
+    using Simulator::Simulator;
+
+private:
+    typedef std::pair<unsigned int, unsigned long> deadline_key;    // (absolute deadline, ready sequence)
+    indexed_heap<deadline_key> ready_queue;
+    unsigned long ready_sequence = 0;
+
+    io_scheduler wait_queue{io_devices, io_horizon};    // I/O and page-fault completions by index, per-device queues
+
+    std::set<size_t> pending;       // arrived but no partition yet, kept in input order
+    bool memory_freed = false;      // pending admissions can only succeed after a partition is freed
+    int running = -1;               // index of the running process, -1 when idle
+
+    std::vector<size_t> arrivals;   // arrival order (stable, so same-tick arrivals keep input order)
+    size_t next_arrival = 0;
+
+    //From the process table, not metrics: a what-if restore changes the process there, metrics keep the original
+    unsigned int absolute_deadline(size_t i) const {
+        const PCB &p = list_process[i];
+        return p.deadline > 0 ? p.arrival_time + p.deadline : NO_DEADLINE;
+    }
+
+    void make_ready(size_t i) {
+        ready_queue.push(i, {absolute_deadline(i), ready_sequence++});
+    }
+
+    bool admit(size_t i) override {
+        if (!assign_memory(list_process[i], current_time)) return false;
+        transition(current_time, i, NEW, READY);
+        make_ready(i);
+        return true;
+    }
+
+    void start() override {
+        ready_queue = indexed_heap<deadline_key>();
+        ready_sequence = 0;
+        wait_queue = io_scheduler(io_devices, io_horizon);
+        pending.clear();
+        memory_freed = false;
+        running = -1;
+
+        keep_metrics();
+
+        order_arrivals(arrivals, next_arrival);
+    }
+
+    void process_added(size_t index) override {
+        add_arrival(arrivals, next_arrival, index);
+    }
+
+    bool stalled() const override {
+        return running == -1 && ready_queue.empty() && wait_queue.empty() && next_arrival == total_processes &&
+               !admission_possible(current_time);
+    }
+
+    // everything tick() carries from one tick to the next, for checkpoints
+    void archive_state(state_archive &ar) override {
+        archive(ar, ready_queue);
+        archive_history(ar, ready_sequence);
+        archive(ar, wait_queue);
+        archive(ar, pending);
+        archive(ar, memory_freed);
+        archive(ar, running);
+        archive_arrivals(ar, arrivals, next_arrival);
+        archive_history(ar, metrics);
+    }
+
+    std::string policy_signature() const override {
+        return "EDF";
+    }
+
+    void tick() override {
+        // --- arrivals at this tick ---
+        admit_arrivals(arrivals, next_arrival, pending);
+
+        // Retry to assign memory for earlier arrivals that couldn't fit
+        retry_pending(pending, memory_freed);
+
+        // --- handle I/O completions scheduled for this tick ---
+        size_t i;
+        while (wait_queue.next_completion(current_time, i)) {
+            transition(current_time, i, WAITING, READY);
+            make_ready(i);
+        }
+
+        // --- Preemption: a ready process has an earlier deadline than the running one ---
+        if (running != -1 && !ready_queue.empty()) {
+            size_t top = ready_queue.top();
+            if (absolute_deadline(top) < absolute_deadline(running)) {
+                // preempt now (at current_time)
+                transition(current_time, running, RUNNING, READY);
+                make_ready(running);
+                running = -1;
+            }
+        }
+
+        // --- Scheduler dispatch if CPU idle ---
+        if (running == -1 && !ready_queue.empty()) {
+            running = ready_queue.pop();
+            list_process[running].start_time = current_time;
+            transition(current_time, running, READY, RUNNING);
+        }
+
+        // --- page fault: this ms is spent trapping, the process waits for the page ---
+        if (running != -1 && page_fault(list_process[running], current_time)) {
+            transition(current_time + 1, running, RUNNING, WAITING);
+            wait_queue.submit(current_time + 1, -1, options.page_fault_time, running, list_process[running].PID);
+            running = -1;
+        }
+
+        // --- Execute one ms of CPU if running ---
+        if (running != -1) {
+            PCB &p = list_process[running];
+            p.remaining_time--;
+
+            unsigned int executed_time = p.processing_time - p.remaining_time;
+            unsigned int transition_time = current_time + 1;
+
+            if (p.io_freq > 0 && executed_time > 0 && (executed_time % p.io_freq) == 0 && p.remaining_time > 0) {
+                transition(transition_time, running, RUNNING, WAITING);
+                wait_queue.submit(transition_time, p.device, p.io_duration, running, p.PID);
+                running = -1;
+            } else if (p.remaining_time == 0) {
+                transition(transition_time, running, RUNNING, TERMINATED);
+                free_memory(p, transition_time);
+                memory_freed = true;
+                terminated_count++;
+                running = -1;
+            }
+        }
+    }
+};
+
+std::unique_ptr<Simulator> make_edf_simulator(const std::vector<std::string> &args, const simulator_options &options) {
+    if (!args.empty()) {
+        std::cerr << "Error: EDF takes no arguments" << std::endl;
+        return nullptr;
+    }
+    if (!swapping_supported("EDF", options)) return nullptr;
+    return std::make_unique<edf_simulator>(options);
+}
@@ -0,0 +1,198 @@
+#include "interrupts_101268848_101281787.hpp"
+
+// Non-preemptive external priorities (smaller PID -> higher priority)
+
+class ep_simulator : public Simulator {
+public:
+    using Simulator::Simulator;
+
+private:
+    std::vector<PCB> ready_queue;
+    wait_list wait_queue;     // (pcb, completion_time) by the time it started waiting
+    std::vector<PCB> job_list;
+    PCB running;
+    swap_space swap;
+    io_scheduler io{io_devices, io_horizon};    // I/O and page-fault completions by wait_queue key, per-device queues
+
+    void try_assign_pending(unsigned int now) {
+        for (auto &p : list_process) {
+            if (p.arrival_time <= now && p.state == NOT_ASSIGNED) {
+                if (assign_memory(p, now)) {
+                    p.state = READY;
+                    ready_queue.push_back(p);
+                    emit(now, p.PID, NEW, READY);
+                    // update job_list
+                    bool found=false;
+                    for(auto &j:job_list) if(j.PID==p.PID) { j = p; found=true; break; }
+                    if(!found) job_list.push_back(p);
+                }
+            }
+        }
+    }
+
+    bool pick_highest_priority() {
+        if (ready_queue.empty()) return false;
+        // smaller PID = higher priority. sort so smallest at back for pop_back
+        std::sort(ready_queue.begin(), ready_queue.end(), [](const PCB &a, const PCB &b){ return a.PID > b.PID; });
+        PCB next = ready_queue.back();
+        ready_queue.pop_back();
+        next.state = RUNNING;
+        next.start_time = current_time;
+        emit(current_time, next.PID, READY, RUNNING);
+        // sync
+        for (auto &lp : list_process) if (lp.PID == next.PID) lp = next;
+        bool found=false;
+        for (auto &jp : job_list) if (jp.PID == next.PID) { jp = next; found=true; break; }
+        if(!found) job_list.push_back(next);
+        running = next;
+        return true;
+    }
+
+    void start() override {
+        ready_queue.clear();
+        wait_queue.clear();
+        job_list.clear();
+        idle_CPU(running);
+        swap = swap_space();
+        io = io_scheduler(io_devices, io_horizon);
+
+        // process arrivals at time 0
+        for (auto &p : list_process) {
+            if (p.arrival_time == 0) {
+                if (assign_memory(p)) {
+                    p.state = READY;
+                    ready_queue.push_back(p);
+                    emit(0, p.PID, NEW, READY);
+                } else {
+                    p.state = NOT_ASSIGNED;
+                }
+                job_list.push_back(p);
+            }
+        }
+    }
+
+    bool stalled() const override {
+        return running.PID == -1 && ready_queue.empty() && wait_queue.empty() &&
+               swap.swapping_out.empty() && swap.swapping_in.empty() && swap.suspended.empty() &&
+               std::none_of(list_process.begin(), list_process.end(), [&](const PCB &p){
+                   return p.state == NOT_ASSIGNED && p.arrival_time >= current_time;
+               }) &&
+               !admission_possible(current_time);
+    }
+
+    // everything tick() carries from one tick to the next, for checkpoints
+    void archive_state(state_archive &ar) override {
+        archive(ar, ready_queue);
+        archive(ar, wait_queue);
+        archive_history(ar, job_list);
+        archive(ar, running);
+        archive(ar, swap);
+        archive(ar, io);
+    }
+
+    std::string policy_signature() const override {
+        return "EP";
+    }
+
+    void tick() override {
+        // arrivals at this tick
+        for (auto &p : list_process) {
+            if (p.arrival_time == current_time && p.arrival_time != 0) {
+                // try assign memory
+                if (assign_memory(p, current_time)) {
+                    p.state = READY;
+                    ready_queue.push_back(p);
+                    emit(current_time, p.PID, NEW, READY);
+                } else {
+                    p.state = NOT_ASSIGNED;
+                }
+                bool found=false;
+                for(auto &j:job_list) if(j.PID==p.PID) { found=true; j=p; break; }
+                if(!found) job_list.push_back(p);
+            }
+        }
+
+        try_assign_pending(current_time);
+
+        // I/O completions
+        size_t completed;
+        while (io.next_completion(current_time, completed)) {
+            auto it = wait_queue.find(completed);
+            PCB &waiter = it->second.first;
+            if (waiter.state == SUSPENDED_WAITING) {
+                // I/O finished while swapped out, it stays on the backing store until swapped in
+                for (auto &lp : list_process) if (lp.PID == waiter.PID) lp = waiter;
+                suspended_io_done(swap, waiter, current_time);
+            } else {
+                PCB p = waiter;
+                p.state = READY;
+                emit(current_time, p.PID, WAITING, READY);
+                // update lists
+                for (auto &lp : list_process) if (lp.PID == p.PID) lp = p;
+                for (auto &jp : job_list) if (jp.PID == p.PID) jp = p;
+                ready_queue.push_back(p);
+            }
+            wait_queue.erase(it);
+        }
+
+        // medium-term scheduler: swap processes out for pending arrivals and back in when memory frees up
+        medium_term_scheduler(swap, ready_queue, wait_queue, current_time);
+
+        // schedule (non-preemptive) if CPU idle
+        if (running.PID == -1) {
+            if (!ready_queue.empty()) {
+                pick_highest_priority();
+            }
+        }
+
+        // page fault: this ms is spent trapping, RUNNING -> WAITING until the page is loaded
+        if (running.PID != -1 && page_fault(running, current_time)) {
+            emit(current_time + 1, running.PID, RUNNING, WAITING);
+            PCB p = running;
+            p.state = WAITING;
+            wait_queue[current_time + 1] = {p, io.submit(current_time + 1, -1, options.page_fault_time, current_time + 1, p.PID)};
+            for (auto &lp : list_process) if (lp.PID == p.PID) lp = p;
+            for (auto &jp : job_list) if (jp.PID == p.PID) jp = p;
+            idle_CPU(running);
+        }
+
+        // execute 1 ms if running
+        if (running.PID != -1) {
+            running.remaining_time--;
+            for (auto &lp : list_process) if (lp.PID == running.PID) lp = running;
+            for (auto &jp : job_list) if (jp.PID == running.PID) jp = running;
+
+            unsigned int executed_time = running.processing_time - running.remaining_time;
+            unsigned int transition_time = current_time + 1;
+
+            if (running.io_freq > 0 && executed_time > 0 && (executed_time % running.io_freq) == 0 && running.remaining_time > 0) {
+                // RUNNING -> WAITING
+                emit(transition_time, running.PID, RUNNING, WAITING);
+                PCB p = running;
+                p.state = WAITING;
+                unsigned int completion_time = io.submit(transition_time, p.device, p.io_duration, transition_time, p.PID);
+                wait_queue[transition_time] = {p, completion_time};
+                // update job_list/list_process
+                for (auto &lp : list_process) if (lp.PID == p.PID) lp = p;
+                for (auto &jp : job_list) if (jp.PID == p.PID) jp = p;
+                idle_CPU(running);
+            } else if (running.remaining_time == 0) {
+                emit(transition_time, running.PID, RUNNING, TERMINATED);
+                terminate_process(running, job_list, transition_time);
+                sync_queue(list_process, running);
+                terminated_count++;
+                idle_CPU(running);
+            } else {
+                // continue running (non-preemptive)
+            }
+        }
+    }
+};
+
+std::unique_ptr<Simulator> make_ep_simulator(const std::vector<std::string> &args, const simulator_options &options) {
+    if (!args.empty()) {
+        std::cerr << "Error: EP takes no arguments" << std::endl;
+        return nullptr;
+    }
+    return std::make_unique<ep_simulator>(options);
+}
@@ -0,0 +1,224 @@
+#include "interrupts_101268848_101281787.hpp"
+
+const int RR_ER_QUANTUM = 100;
+
+// smaller PID -> higher priority
+// Round-Robin among same-priority values (i.e., same PID ordering ties unlikely unless equal PID)
+
+class ep_rr_simulator : public Simulator {
+public:
+    using Simulator::Simulator;
+
+private:
+    std::vector<PCB> ready_queue;
+    wait_list wait_queue;     // (pcb, completion_time) by the time it started waiting
+    std::vector<PCB> job_list;
+    PCB running;
+    swap_space swap;
+    io_scheduler io{io_devices, io_horizon};    // I/O and page-fault completions by wait_queue key, per-device queues
+
+    void try_assign_pending(unsigned int now) {
+        for (auto &p : list_process) {
+            if (p.arrival_time <= now && p.state == NOT_ASSIGNED) {
+                if (assign_memory(p, now)) {
+                    p.state = READY;
+                    ready_queue.push_back(p);
+                    emit(now, p.PID, NEW, READY);
+                    bool found=false;
+                    for(auto &j:job_list) if(j.PID==p.PID) { j=p; found=true; break; }
+                    if(!found) job_list.push_back(p);
+                }
+            }
+        }
+    }
+
+    void sort_ready_by_priority() {
+        std::sort(ready_queue.begin(), ready_queue.end(), [](const PCB &a, const PCB &b){ return a.PID > b.PID; });
+    }
+
+    void start() override {
+        ready_queue.clear();
+        wait_queue.clear();
+        job_list.clear();
+        idle_CPU(running);
+        swap = swap_space();
+        io = io_scheduler(io_devices, io_horizon);
+
+        // arrivals at time 0
+        for (auto &p : list_process) {
+            if (p.arrival_time == 0) {
+                if (assign_memory(p)) {
+                    p.state = READY;
+                    ready_queue.push_back(p);
+                    emit(0, p.PID, NEW, READY);
+                } else {
+                    p.state = NOT_ASSIGNED;
+                }
+                job_list.push_back(p);
+            }
+        }
+    }
+
+    bool stalled() const override {
+        return running.PID == -1 && ready_queue.empty() && wait_queue.empty() &&
+               swap.swapping_out.empty() && swap.swapping_in.empty() && swap.suspended.empty() &&
+               std::none_of(list_process.begin(), list_process.end(), [&](const PCB &p){
+                   return p.state == NOT_ASSIGNED && p.arrival_time >= current_time;
+               }) &&
+               !admission_possible(current_time);
+    }
+
+    // everything tick() carries from one tick to the next, for checkpoints
+    void archive_state(state_archive &ar) override {
+        archive(ar, ready_queue);
+        archive(ar, wait_queue);
+        archive_history(ar, job_list);
+        archive(ar, running);
+        archive(ar, swap);
+        archive(ar, io);
+    }
+
+    std::string policy_signature() const override {
+        return "EP_RR";
+    }
+
+    void tick() override {
+        // arrivals at this tick
+        for (auto &p : list_process) {
+            if (p.arrival_time == current_time && p.arrival_time != 0) {
+                if (assign_memory(p, current_time)) {
+                    p.state = READY;
+                    ready_queue.push_back(p);
+                    emit(current_time, p.PID, NEW, READY);
+                } else {
+                    p.state = NOT_ASSIGNED;
+                }
+                bool found=false;
+                for(auto &j:job_list) if(j.PID==p.PID) { j=p; found=true; break; }
+                if(!found) job_list.push_back(p);
+            }
+        }
+
+        try_assign_pending(current_time);
+
+        // handle io completions
+        size_t completed;
+        while (io.next_completion(current_time, completed)) {
+            auto it = wait_queue.find(completed);
+            PCB &waiter = it->second.first;
+            if (waiter.state == SUSPENDED_WAITING) {
+                // I/O finished while swapped out, it stays on the backing store until swapped in
+                for (auto &lp : list_process) if (lp.PID == waiter.PID) lp = waiter;
+                suspended_io_done(swap, waiter, current_time);
+            } else {
+                PCB p = waiter;
+                p.state = READY;
+                emit(current_time, p.PID, WAITING, READY);
+                for (auto &lp : list_process) if (lp.PID == p.PID) lp = p;
+                for (auto &jp : job_list) if (jp.PID == p.PID) jp = p;
+                ready_queue.push_back(p);
+            }
+            wait_queue.erase(it);
+        }
+
+        // medium-term scheduler: swap processes out for pending arrivals and back in when memory frees up
+        medium_term_scheduler(swap, ready_queue, wait_queue, current_time);
+
+        // sort ready by priority to see top
+        sort_ready_by_priority();
+
+        // Preemption: if a higher-priority process is ready (smaller PID) than running -> preempt immediately
+        if (running.PID != -1 && !ready_queue.empty()) {
+            PCB top = ready_queue.back();
+            if (top.PID < running.PID) {
+                // preempt now (at current_time)
+                emit(current_time, running.PID, RUNNING, READY);
+                running.state = READY;
+                for (auto &lp : list_process) if (lp.PID == running.PID) lp = running;
+                for (auto &jp : job_list) if (jp.PID == running.PID) jp = running;
+                // dispatch top immediately, the preempted process goes back to the ready queue
+                ready_queue.pop_back();
+                ready_queue.push_back(running);
+                PCB next = top;
+                next.state = RUNNING;
+                next.start_time = current_time;
+                emit(current_time, next.PID, READY, RUNNING);
+                for (auto &lp : list_process) if (lp.PID == next.PID) lp = next;
+                for (auto &jp : job_list) if (jp.PID == next.PID) jp = next;
+                running = next;
+            }
+        }
+
+        // If CPU idle, dispatch highest priority
+        if (running.PID == -1) {
+            if (!ready_queue.empty()) {
+                sort_ready_by_priority();
+                PCB next = ready_queue.back();
+                ready_queue.pop_back();
+                next.state = RUNNING;
+                next.start_time = current_time;
+                emit(current_time, next.PID, READY, RUNNING);
+                for (auto &lp : list_process) if (lp.PID == next.PID) lp = next;
+                bool found=false;
+                for(auto &jp:job_list) if(jp.PID==next.PID) { jp=next; found=true; break; }
+                if(!found) job_list.push_back(next);
+                running = next;
+            }
+        }
+
+        // page fault: this ms is spent trapping, RUNNING -> WAITING until the page is loaded
+        if (running.PID != -1 && page_fault(running, current_time)) {
+            emit(current_time + 1, running.PID, RUNNING, WAITING);
+            PCB p = running;
+            p.state = WAITING;
+            wait_queue[current_time + 1] = {p, io.submit(current_time + 1, -1, options.page_fault_time, current_time + 1, p.PID)};
+            for (auto &lp : list_process) if (lp.PID == p.PID) lp = p;
+            for (auto &jp : job_list) if (jp.PID == p.PID) jp = p;
+            idle_CPU(running);
+        }
+
+        // execute 1 ms if running
+        if (running.PID != -1) {
+            running.remaining_time--;
+            for (auto &lp : list_process) if (lp.PID == running.PID) lp = running;
+            for (auto &jp : job_list) if (jp.PID == running.PID) jp = running;
+
+            unsigned int executed_time = running.processing_time - running.remaining_time;
+            unsigned int transition_time = current_time + 1;
+
+            if (running.io_freq > 0 && executed_time > 0 && (executed_time % running.io_freq) == 0 && running.remaining_time > 0) {
+                // RUNNING -> WAITING
+                emit(transition_time, running.PID, RUNNING, WAITING);
+                PCB p = running;
+                p.state = WAITING;
+                unsigned int completion_time = io.submit(transition_time, p.device, p.io_duration, transition_time, p.PID);
+                wait_queue[transition_time] = {p, completion_time};
+                for (auto &lp : list_process) if (lp.PID == p.PID) lp = p;
+                for (auto &jp : job_list) if (jp.PID == p.PID) jp = p;
+                idle_CPU(running);
+            } else if (running.remaining_time == 0) {
+                emit(transition_time, running.PID, RUNNING, TERMINATED);
+                terminate_process(running, job_list, transition_time);
+                sync_queue(list_process, running);
+                terminated_count++;
+                idle_CPU(running);
+            } else if ((current_time - running.start_time + 1) % RR_ER_QUANTUM == 0) {
+                // Round-robin among same-priority: preempt at transition_time
+                emit(transition_time, running.PID, RUNNING, READY);
+                running.state = READY;
+                ready_queue.push_back(running);
+                for (auto &lp : list_process) if (lp.PID == running.PID) lp = running;
+                for (auto &jp : job_list) if (jp.PID == running.PID) jp = running;
+                idle_CPU(running);
+            }
+        }
+    }
+};
+
+std::unique_ptr<Simulator> make_ep_rr_simulator(const std::vector<std::string> &args, const simulator_options &options) {
+    if (!args.empty()) {
+        std::cerr << "Error: EP_RR takes no arguments" << std::endl;
+        return nullptr;
+    }
+    return std::make_unique<ep_rr_simulator>(options);
+}
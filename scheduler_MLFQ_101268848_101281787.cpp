@@ -0,0 +1,226 @@
+#include "interrupts_101268848_101281787.hpp"
+
+// Multi-level feedback queue scheduler
+// - level 0 is the highest priority; each level has its own quantum
+// - a process that uses up the quantum of its level is demoted one level
+// - a process coming back from I/O is promoted one level
+// - every MLFQ_BOOST_PERIOD ms every process is boosted back to level 0
+// - a process arriving in a higher level preempts the running one
+// Each level is a ring_queue and a bitmap of non-empty levels gives an O(1) pick-next.
+
+const int MLFQ_MAX_LEVELS = 64;
+const std::vector<unsigned int> MLFQ_DEFAULT_QUANTA = {25, 50, 100};
+const unsigned int MLFQ_DEFAULT_BOOST_PERIOD = 1000;
+
+struct mlfq_config {
+    std::vector<unsigned int>   quanta;         // one quantum per level
+    unsigned int                boost_period;   // 0 disables the periodic boost
+};
+
+struct mlfq_entry {
+    int             level;
+    unsigned int    quantum_used;
+};
+
+class mlfq_simulator : public Simulator {
+public:
+    mlfq_simulator(const mlfq_config &config, const simulator_options &options)
+        : Simulator(options), config(config), levels(config.quanta.size()) {}
+
+private:
+    const mlfq_config config;
+    const int levels;
+    std::vector<ring_queue<size_t>> ready_queue;    // indices into list_process
+    uint64_t ready_levels = 0;                      // bit i set <=> ready_queue[i] non-empty
+    std::vector<mlfq_entry> mlfq;
+
+    io_scheduler wait_queue{io_devices, io_horizon};    // I/O and page-fault completions by index, per-device queues
+
+    std::set<size_t> pending;       // arrived but no partition yet, kept in input order
+    bool memory_freed = false;      // pending admissions can only succeed after a partition is freed
+    int running = -1;               // index of the running process, -1 when idle
+
+    std::vector<size_t> arrivals;   // arrival order (stable, so same-tick arrivals keep input order)
+    size_t next_arrival = 0;
+
+    void enqueue(size_t i) {
+        int level = mlfq[i].level;
+        ready_queue[level].push_back(i);
+        ready_levels |= (uint64_t(1) << level);
+    }
+
+    size_t dequeue_highest() {
+        int level = __builtin_ctzll(ready_levels);
+        size_t i = ready_queue[level].front();
+        ready_queue[level].pop_front();
+        if (ready_queue[level].empty()) ready_levels &= ~(uint64_t(1) << level);
+        return i;
+    }
+
+    bool admit(size_t i) override {
+        PCB &p = list_process[i];
+        if (!assign_memory(p, current_time)) return false;
+        p.state = READY;
+        enqueue(i);
+        emit(current_time, p.PID, NEW, READY);
+        return true;
+    }
+
+    void start() override {
+        ready_queue.assign(levels, ring_queue<size_t>());
+        ready_levels = 0;
+        mlfq.assign(total_processes, {0, 0});
+        wait_queue = io_scheduler(io_devices, io_horizon);
+        pending.clear();
+        memory_freed = false;
+        running = -1;
+
+        order_arrivals(arrivals, next_arrival);
+    }
+
+    void process_added(size_t index) override {
+        mlfq.push_back({0, 0});
+        add_arrival(arrivals, next_arrival, index);
+    }
+
+    bool stalled() const override {
+        return running == -1 && ready_levels == 0 && wait_queue.empty() && next_arrival == total_processes &&
+               !admission_possible(current_time);
+    }
+
+    // everything tick() carries from one tick to the next, for checkpoints
+    void archive_state(state_archive &ar) override {
+        archive(ar, ready_queue);
+        archive(ar, ready_levels);
+        archive(ar, mlfq);
+        archive(ar, wait_queue);
+        archive(ar, pending);
+        archive(ar, memory_freed);
+        archive(ar, running);
+        archive_arrivals(ar, arrivals, next_arrival);
+    }
+
+    std::string policy_signature() const override {
+        std::string signature = "MLFQ";
+        for (int level = 0; level < levels; level++) signature += (level ? "," : " ") + std::to_string(config.quanta[level]);
+        return signature + " " + std::to_string(config.boost_period);
+    }
+
+    void tick() override {
+        // --- arrivals at this tick ---
+        admit_arrivals(arrivals, next_arrival, pending);
+
+        // Retry to assign memory for earlier arrivals that couldn't fit
+        retry_pending(pending, memory_freed);
+
+        // --- handle I/O completions scheduled for this tick (promote one level) ---
+        size_t i;
+        while (wait_queue.next_completion(current_time, i)) {
+            list_process[i].state = READY;
+            emit(current_time, list_process[i].PID, WAITING, READY);
+            if (mlfq[i].level > 0) {
+                mlfq[i].level--;
+                mlfq[i].quantum_used = 0;
+            }
+            enqueue(i);
+        }
+
+        // --- periodic priority boost ---
+        if (config.boost_period > 0 && current_time > 0 && current_time % config.boost_period == 0) {
+            for (int level = 1; level < levels; level++) {
+                while (!ready_queue[level].empty()) {
+                    size_t i = ready_queue[level].front();
+                    ready_queue[level].pop_front();
+                    ready_queue[0].push_back(i);
+                }
+            }
+            if (ready_levels != 0) ready_levels = 1;
+            for (auto &entry : mlfq) entry = {0, 0};
+        }
+
+        // --- preemption: a higher level became ready while a lower level is running ---
+        if (running != -1 && ready_levels != 0 && __builtin_ctzll(ready_levels) < mlfq[running].level) {
+            PCB &p = list_process[running];
+            emit(current_time, p.PID, RUNNING, READY);
+            p.state = READY;
+            enqueue(running);
+            running = -1;
+        }
+
+        // --- Scheduler dispatch if CPU idle ---
+        if (running == -1 && ready_levels != 0) {
+            running = dequeue_highest();
+            PCB &p = list_process[running];
+            p.state = RUNNING;
+            p.start_time = current_time;
+            emit(current_time, p.PID, READY, RUNNING);
+        }
+
+        // --- page fault: this ms is spent trapping, the process waits for the page ---
+        if (running != -1 && page_fault(list_process[running], current_time)) {
+            PCB &p = list_process[running];
+            emit(current_time + 1, p.PID, RUNNING, WAITING);
+            p.state = WAITING;
+            wait_queue.submit(current_time + 1, -1, options.page_fault_time, running, list_process[running].PID);
+            running = -1;
+        }
+
+        // --- Execute one ms of CPU if running ---
+        if (running != -1) {
+            PCB &p = list_process[running];
+            p.remaining_time--;
+            mlfq[running].quantum_used++;
+
+            unsigned int executed_time = p.processing_time - p.remaining_time;
+            unsigned int transition_time = current_time + 1;
+
+            if (p.io_freq > 0 && executed_time > 0 && (executed_time % p.io_freq) == 0 && p.remaining_time > 0) {
+                // RUNNING -> WAITING, keeps what is left of its quantum at this level
+                emit(transition_time, p.PID, RUNNING, WAITING);
+                p.state = WAITING;
+                wait_queue.submit(transition_time, p.device, p.io_duration, running, p.PID);
+                running = -1;
+            } else if (p.remaining_time == 0) {
+                emit(transition_time, p.PID, RUNNING, TERMINATED);
+                p.state = TERMINATED;
+                free_memory(p, transition_time);
+                memory_freed = true;
+                terminated_count++;
+                running = -1;
+            } else if (mlfq[running].quantum_used >= config.quanta[mlfq[running].level]) {
+                // quantum of this level used up -> demote
+                emit(transition_time, p.PID, RUNNING, READY);
+                p.state = READY;
+                mlfq[running].level = std::min(mlfq[running].level + 1, levels - 1);
+                mlfq[running].quantum_used = 0;
+                enqueue(running);
+                running = -1;
+            }
+        }
+    }
+};
+
+std::unique_ptr<Simulator> make_mlfq_simulator(const std::vector<std::string> &args, const simulator_options &options) {
+    if (args.size() > 2) {
+        std::cerr << "Error: MLFQ takes at most 2 arguments: [quanta, e.g. 25,50,100] [boost_period]" << std::endl;
+        return nullptr;
+    }
+
+    if (!swapping_supported("MLFQ", options)) return nullptr;
+
+    mlfq_config config = {MLFQ_DEFAULT_QUANTA, MLFQ_DEFAULT_BOOST_PERIOD};
+    if (args.size() >= 1) {
+        config.quanta.clear();
+        for (auto &token : split_delim(args[0], ",")) {
+            unsigned int quantum;
+            if (!parse_number("MLFQ quantum", token, quantum, 1)) return nullptr;
+            config.quanta.push_back(quantum);
+        }
+        if (config.quanta.size() > MLFQ_MAX_LEVELS) {
+            std::cerr << "Error: at most " << MLFQ_MAX_LEVELS << " levels are supported" << std::endl;
+            return nullptr;
+        }
+    }
+    if (args.size() == 2 && !parse_number("MLFQ boost_period", args[1], config.boost_period)) return nullptr;
+    return std::make_unique<mlfq_simulator>(config, options);
+}
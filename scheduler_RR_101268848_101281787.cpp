@@ -0,0 +1,217 @@
+#include "interrupts_101268848_101281787.hpp"
+
+// Round Robin scheduler (quantum = 100 ms)
+// Uses print_exec_* from interrupts.hpp which produces the 49-width table.
+
+const int RR_QUANTUM = 100;
+
+class rr_simulator : public Simulator {
+public:
+    using Simulator::Simulator;
+
+private:
+    std::vector<PCB> ready_queue;
+    wait_list wait_queue;     // (pcb, completion_time) by the time it started waiting
+    std::vector<PCB> job_list; // mirror of processes that have been seen/assigned
+    PCB running;
+    swap_space swap;
+    io_scheduler io{io_devices, io_horizon};    // I/O and page-fault completions by wait_queue key, per-device queues
+
+    // Helper: try assign NOT_ASSIGNED processes whose arrival <= current_time
+    void try_assign_pending(unsigned int now) {
+        for (auto &p : list_process) {
+            if (p.arrival_time <= now && p.state == NOT_ASSIGNED) {
+                if (assign_memory(p, now)) {
+                    p.state = READY;
+                    ready_queue.push_back(p);
+                    emit(now, p.PID, NEW, READY);
+                    // add to job_list if not already present
+                    bool found=false;
+                    for(auto &j:job_list) if(j.PID==p.PID) { found=true; j = p; break; }
+                    if(!found) job_list.push_back(p);
+                }
+            }
+        }
+    }
+
+    void start() override {
+        ready_queue.clear();
+        wait_queue.clear();
+        job_list.clear();
+        idle_CPU(running);
+        swap = swap_space();
+        io = io_scheduler(io_devices, io_horizon);
+
+        // initialize processes with arrival_time == 0
+        for (auto &p : list_process) {
+            if (p.arrival_time == 0) {
+                if (assign_memory(p)) {
+                    p.state = READY;
+                    ready_queue.push_back(p);
+                    job_list.push_back(p);
+                    emit(0, p.PID, NEW, READY);
+                } else {
+                    p.state = NOT_ASSIGNED;
+                    job_list.push_back(p);
+                }
+            } else {
+                // not arrived yet: mark as NOT_ASSIGNED so we can attempt assign after arrival
+                p.state = NOT_ASSIGNED;
+            }
+        }
+    }
+
+    bool stalled() const override {
+        return running.PID == -1 && ready_queue.empty() && wait_queue.empty() &&
+               swap.swapping_out.empty() && swap.swapping_in.empty() && swap.suspended.empty() &&
+               std::none_of(list_process.begin(), list_process.end(), [&](const PCB &p){
+                   return p.state == NOT_ASSIGNED && p.arrival_time >= current_time;
+               }) &&
+               !admission_possible(current_time);
+    }
+
+    // everything tick() carries from one tick to the next, for checkpoints
+    void archive_state(state_archive &ar) override {
+        archive(ar, ready_queue);
+        archive(ar, wait_queue);
+        archive_history(ar, job_list);
+        archive(ar, running);
+        archive(ar, swap);
+        archive(ar, io);
+    }
+
+    std::string policy_signature() const override {
+        return "RR";
+    }
+
+    void tick() override {
+        // --- arrivals at this tick ---
+        for (auto &p : list_process) {
+            if (p.arrival_time == current_time && p.arrival_time != 0) {
+                // mark NOT_ASSIGNED first (if not already)
+                if (p.state == NOT_ASSIGNED) {
+                    if (assign_memory(p, current_time)) {
+                        p.state = READY;
+                        ready_queue.push_back(p);
+                        emit(current_time, p.PID, NEW, READY);
+                    } else {
+                        // remain NOT_ASSIGNED; will retry next ticks
+                        p.state = NOT_ASSIGNED;
+                    }
+                    // ensure in job_list
+                    bool found=false;
+                    for(auto &j:job_list) if(j.PID==p.PID) { found=true; j=p; break; }
+                    if(!found) job_list.push_back(p);
+                }
+            }
+        }
+
+        // Retry to assign memory for earlier arrivals that couldn't fit
+        try_assign_pending(current_time);
+
+        // --- handle I/O completions scheduled for this tick ---
+        size_t completed;
+        while (io.next_completion(current_time, completed)) {
+            auto it = wait_queue.find(completed);
+            PCB &waiter = it->second.first;
+            if (waiter.state == SUSPENDED_WAITING) {
+                // I/O finished while swapped out, it stays on the backing store until swapped in
+                for (auto &lp : list_process) if (lp.PID == waiter.PID) lp = waiter;
+                suspended_io_done(swap, waiter, current_time);
+            } else {
+                PCB p = waiter;
+                p.state = READY;
+                emit(current_time, p.PID, WAITING, READY);
+                // update list_process & job_list entry
+                for (auto &lp : list_process) if (lp.PID == p.PID) lp = p;
+                for (auto &jp : job_list) if (jp.PID == p.PID) jp = p;
+                ready_queue.push_back(p);
+            }
+            wait_queue.erase(it);
+        }
+
+        // medium-term scheduler: swap processes out for pending arrivals and back in when memory frees up
+        medium_term_scheduler(swap, ready_queue, wait_queue, current_time);
+
+        // --- Scheduler dispatch if CPU idle ---
+        if (running.PID == -1) {
+            if (!ready_queue.empty()) {
+                PCB next = ready_queue.front();
+                ready_queue.erase(ready_queue.begin());
+                next.state = RUNNING;
+                next.start_time = current_time;
+                // sync into job_list/list_process
+                for (auto &lp : list_process) if (lp.PID == next.PID) lp = next;
+                for (auto &jp : job_list) if (jp.PID == next.PID) jp = next;
+                emit(current_time, next.PID, READY, RUNNING);
+                running = next;
+            }
+        }
+
+        // page fault: this ms is spent trapping, RUNNING -> WAITING until the page is loaded
+        if (running.PID != -1 && page_fault(running, current_time)) {
+            emit(current_time + 1, running.PID, RUNNING, WAITING);
+            PCB p = running;
+            p.state = WAITING;
+            wait_queue[current_time + 1] = {p, io.submit(current_time + 1, -1, options.page_fault_time, current_time + 1, p.PID)};
+            for (auto &lp : list_process) if (lp.PID == p.PID) lp = p;
+            for (auto &jp : job_list) if (jp.PID == p.PID) jp = p;
+            idle_CPU(running);
+        }
+
+        // --- Execute one ms of CPU if running ---
+        if (running.PID != -1) {
+            running.remaining_time--;
+            // update in job_list/list_process
+            for (auto &lp : list_process) if (lp.PID == running.PID) lp = running;
+            for (auto &jp : job_list) if (jp.PID == running.PID) jp = running;
+
+            unsigned int executed_time = running.processing_time - running.remaining_time;
+            unsigned int transition_time = current_time + 1; // events from this ms are timestamped at current_time+1
+
+            // I/O request after this ms?
+            if (running.io_freq > 0 && executed_time > 0 && (executed_time % running.io_freq) == 0 && running.remaining_time > 0) {
+                // RUNNING -> WAITING at transition_time
+                emit(transition_time, running.PID, RUNNING, WAITING);
+                // schedule completion at transition_time + io_duration
+                unsigned int completion_time = io.submit(transition_time, running.device, running.io_duration, transition_time, running.PID);
+                PCB p = running;
+                p.state = WAITING;
+                wait_queue[transition_time] = {p, completion_time};
+                // update job_list/list_process
+                for (auto &lp : list_process) if (lp.PID == p.PID) lp = p;
+                for (auto &jp : job_list) if (jp.PID == p.PID) jp = p;
+                // CPU becomes idle
+                idle_CPU(running);
+            }
+            // Process finished this ms?
+            else if (running.remaining_time == 0) {
+                emit(transition_time, running.PID, RUNNING, TERMINATED);
+                terminate_process(running, job_list, transition_time);
+                sync_queue(list_process, running);
+                terminated_count++;
+                idle_CPU(running);
+            }
+            // RR quantum expiry?
+            else if ((current_time - running.start_time + 1) % RR_QUANTUM == 0) {
+                // preempt at transition_time
+                emit(transition_time, running.PID, RUNNING, READY);
+                running.state = READY;
+                // push to back of ready queue
+                ready_queue.push_back(running);
+                // update job_list/list_process
+                for (auto &lp : list_process) if (lp.PID == running.PID) lp = running;
+                for (auto &jp : job_list) if (jp.PID == running.PID) jp = running;
+                idle_CPU(running);
+            }
+        }
+    }
+};
+
+std::unique_ptr<Simulator> make_rr_simulator(const std::vector<std::string> &args, const simulator_options &options) {
+    if (!args.empty()) {
+        std::cerr << "Error: RR takes no arguments" << std::endl;
+        return nullptr;
+    }
+    return std::make_unique<rr_simulator>(options);
+}
@@ -0,0 +1,173 @@
+#include "interrupts_101268848_101281787.hpp"
+#include <set>
+
+// Shortest-Job-First / Shortest-Remaining-Time-First scheduler keyed on PCB::remaining_time
+// - SJF:  non-preemptive, the ready process with the least remaining time runs to its next I/O or exit
+// - SRTF: a ready process with strictly less remaining time than the running one preempts it
+// The ready set is an indexed_heap; the running process stays in it and its key is decreased
+// every ms it executes, so nothing is re-sorted per tick. Ties are broken FCFS (order of entering READY).
+
+enum burst_policy {
+    SJF,
+    SRTF
+};
+
+class srtf_simulator : public Simulator {
+public:
+    srtf_simulator(burst_policy policy, const simulator_options &options) : Simulator(options), policy(policy) {}
+
+private:
+    const burst_policy policy;
+
+    typedef std::pair<unsigned int, unsigned long> burst_key;   // (remaining_time, ready sequence)
+    indexed_heap<burst_key> ready_queue;                        // READY processes plus the running one
+    unsigned long ready_sequence = 0;
+
+    io_scheduler wait_queue{io_devices, io_horizon};    // I/O and page-fault completions by index, per-device queues
+
+    std::set<size_t> pending;       // arrived but no partition yet, kept in input order
+    bool memory_freed = false;      // pending admissions can only succeed after a partition is freed
+    int running = -1;               // index of the running process, -1 when idle
+
+    std::vector<size_t> arrivals;   // arrival order (stable, so same-tick arrivals keep input order)
+    size_t next_arrival = 0;
+
+    void make_ready(size_t i) {
+        list_process[i].state = READY;
+        ready_queue.push(i, {list_process[i].remaining_time, ready_sequence++});
+    }
+
+    bool admit(size_t i) override {
+        PCB &p = list_process[i];
+        if (!assign_memory(p, current_time)) return false;
+        make_ready(i);
+        emit(current_time, p.PID, NEW, READY);
+        return true;
+    }
+
+    void start() override {
+        ready_queue = indexed_heap<burst_key>();
+        ready_sequence = 0;
+        wait_queue = io_scheduler(io_devices, io_horizon);
+        pending.clear();
+        memory_freed = false;
+        running = -1;
+
+        order_arrivals(arrivals, next_arrival);
+    }
+
+    void process_added(size_t index) override {
+        add_arrival(arrivals, next_arrival, index);
+    }
+
+    bool stalled() const override {
+        return running == -1 && ready_queue.empty() && wait_queue.empty() && next_arrival == total_processes &&
+               !admission_possible(current_time);
+    }
+
+    // everything tick() carries from one tick to the next, for checkpoints
+    void archive_state(state_archive &ar) override {
+        archive(ar, ready_queue);
+        archive_history(ar, ready_sequence);
+        archive(ar, wait_queue);
+        archive(ar, pending);
+        archive(ar, memory_freed);
+        archive(ar, running);
+        archive_arrivals(ar, arrivals, next_arrival);
+    }
+
+    std::string policy_signature() const override {
+        return policy == SJF ? "SJF" : "SRTF";
+    }
+
+    void tick() override {
+        // --- arrivals at this tick ---
+        admit_arrivals(arrivals, next_arrival, pending);
+
+        // Retry to assign memory for earlier arrivals that couldn't fit
+        retry_pending(pending, memory_freed);
+
+        // --- handle I/O completions scheduled for this tick ---
+        size_t i;
+        while (wait_queue.next_completion(current_time, i)) {
+            emit(current_time, list_process[i].PID, WAITING, READY);
+            make_ready(i);
+        }
+
+        // --- SRTF preemption: a ready process needs strictly less time than the running one ---
+        if (policy == SRTF && running != -1) {
+            size_t top = ready_queue.top();
+            if (list_process[top].remaining_time < list_process[running].remaining_time) {
+                PCB &p = list_process[running];
+                emit(current_time, p.PID, RUNNING, READY);
+                p.state = READY;
+                running = -1;
+            }
+        }
+
+        // --- Scheduler dispatch if CPU idle ---
+        if (running == -1 && !ready_queue.empty()) {
+            running = ready_queue.top();
+            PCB &p = list_process[running];
+            p.state = RUNNING;
+            p.start_time = current_time;
+            emit(current_time, p.PID, READY, RUNNING);
+        }
+
+        // --- page fault: this ms is spent trapping, the process waits for the page ---
+        if (running != -1 && page_fault(list_process[running], current_time)) {
+            PCB &p = list_process[running];
+            emit(current_time + 1, p.PID, RUNNING, WAITING);
+            p.state = WAITING;
+            ready_queue.erase(running);
+            wait_queue.submit(current_time + 1, -1, options.page_fault_time, running, list_process[running].PID);
+            running = -1;
+        }
+
+        // --- Execute one ms of CPU if running ---
+        if (running != -1) {
+            PCB &p = list_process[running];
+            p.remaining_time--;
+            // decrease-key: the running process only moves towards the top
+            ready_queue.update(running, {p.remaining_time, ready_queue.key(running).second});
+
+            unsigned int executed_time = p.processing_time - p.remaining_time;
+            unsigned int transition_time = current_time + 1;
+
+            if (p.io_freq > 0 && executed_time > 0 && (executed_time % p.io_freq) == 0 && p.remaining_time > 0) {
+                emit(transition_time, p.PID, RUNNING, WAITING);
+                p.state = WAITING;
+                ready_queue.erase(running);
+                wait_queue.submit(transition_time, p.device, p.io_duration, running, p.PID);
+                running = -1;
+            } else if (p.remaining_time == 0) {
+                emit(transition_time, p.PID, RUNNING, TERMINATED);
+                p.state = TERMINATED;
+                ready_queue.erase(running);
+                free_memory(p, transition_time);
+                memory_freed = true;
+                terminated_count++;
+                running = -1;
+            }
+        }
+    }
+};
+
+std::unique_ptr<Simulator> make_srtf_simulator(const std::vector<std::string> &args, const simulator_options &options) {
+    if (args.size() > 1) {
+        std::cerr << "Error: SRTF takes at most 1 argument: [srtf|sjf]" << std::endl;
+        return nullptr;
+    }
+
+    if (!swapping_supported("SRTF", options)) return nullptr;
+
+    burst_policy policy = SRTF;
+    if (args.size() == 1) {
+        if (args[0] == "sjf") policy = SJF;
+        else if (args[0] != "srtf") {
+            std::cerr << "Error: unknown policy " << args[0] << ", expected srtf or sjf" << std::endl;
+            return nullptr;
+        }
+    }
+    return std::make_unique<srtf_simulator>(policy, options);
+}
@@ -0,0 +1,227 @@
+#include "interrupts_101268848_101281787.hpp"
+#include <set>
+
+// Proportional-share schedulers; a process's share of the CPU follows its tickets (9th input column)
+// - stride:  deterministic; each process advances its pass by STRIDE1 / tickets per ms it runs and the
+//            lowest pass runs next (indexed_heap of pass values, FCFS among equal passes)
+// - lottery: at every dispatch a ticket is drawn with a seeded std::mt19937_64 and its holder runs;
+//            a fenwick_tree over the tickets of READY processes finds the winner in O(log n)
+// Both reschedule at quantum expiry; a process joining the ready set starts at the current global pass.
+
+const unsigned int PS_DEFAULT_QUANTUM = 10;
+const uint64_t PS_DEFAULT_SEED = 4001;
+const uint64_t STRIDE1 = 1 << 20;
+
+enum share_policy {
+    STRIDE,
+    LOTTERY
+};
+
+struct share_config {
+    share_policy    policy;
+    unsigned int    quantum;
+    uint64_t        seed;       // lottery only
+};
+
+class stride_simulator : public Simulator {
+public:
+    stride_simulator(const share_config &config, const simulator_options &options) : Simulator(options), config(config) {}
+
+private:
+    const share_config config;
+
+    typedef std::pair<uint64_t, unsigned long> pass_key;   // (pass, ready sequence)
+    indexed_heap<pass_key> stride_queue;
+    unsigned long ready_sequence = 0;
+    std::vector<uint64_t> pass;
+    uint64_t global_pass = 0;
+
+    fenwick_tree lottery_queue{0};
+    std::mt19937_64 rng;
+    size_t ready_count = 0;
+
+    io_scheduler wait_queue{io_devices, io_horizon};    // I/O and page-fault completions by index, per-device queues
+
+    std::set<size_t> pending;       // arrived but no partition yet, kept in input order
+    bool memory_freed = false;      // pending admissions can only succeed after a partition is freed
+    int running = -1;               // index of the running process, -1 when idle
+    unsigned int quantum_used = 0;
+
+    std::vector<size_t> arrivals;   // arrival order (stable, so same-tick arrivals keep input order)
+    size_t next_arrival = 0;
+
+    void make_ready(size_t i) {
+        ready_count++;
+        if (config.policy == STRIDE) stride_queue.push(i, {pass[i], ready_sequence++});
+        else lottery_queue.add(i, list_process[i].tickets);
+    }
+
+    size_t pick_next() {
+        ready_count--;
+        if (config.policy == STRIDE) {
+            size_t i = stride_queue.pop();
+            global_pass = std::max(global_pass, pass[i]);
+            return i;
+        }
+        uint64_t ticket = std::uniform_int_distribution<uint64_t>(0, lottery_queue.total() - 1)(rng);
+        size_t i = lottery_queue.find(ticket);
+        lottery_queue.add(i, -(int64_t)list_process[i].tickets);
+        return i;
+    }
+
+    bool admit(size_t i) override {
+        if (!assign_memory(list_process[i], current_time)) return false;
+        pass[i] = global_pass;
+        transition(current_time, i, NEW, READY);
+        make_ready(i);
+        return true;
+    }
+
+    void start() override {
+        stride_queue = indexed_heap<pass_key>();
+        ready_sequence = 0;
+        pass.assign(total_processes, 0);
+        global_pass = 0;
+        lottery_queue = fenwick_tree(total_processes);
+        rng.seed(config.seed);
+        ready_count = 0;
+        wait_queue = io_scheduler(io_devices, io_horizon);
+        pending.clear();
+        memory_freed = false;
+        running = -1;
+        quantum_used = 0;
+
+        keep_metrics();
+
+        for (auto &p : list_process) {
+            if (p.tickets == 0) p.tickets = 1;
+        }
+        order_arrivals(arrivals, next_arrival);
+    }
+
+    void process_added(size_t index) override {
+        pass.push_back(0);
+        lottery_queue.push_back();
+        if (list_process[index].tickets == 0) list_process[index].tickets = 1;
+        add_arrival(arrivals, next_arrival, index);
+    }
+
+    // past STRIDE1 tickets the stride rounds to 0: the pass never advances and the process wins every dispatch.
+    // The column is read as an int, so a negative count shows up here as a huge one.
+    bool process_schedulable(const PCB &process) const override {
+        if (process.tickets <= STRIDE1) return true;
+        std::cerr << "Error: process " << process.PID << " has " << (int)process.tickets << " tickets, "
+                  << (config.policy == LOTTERY ? "LOTTERY" : "STRIDE") << " takes 0 to " << STRIDE1 << std::endl;
+        return false;
+    }
+
+    bool stalled() const override {
+        return running == -1 && ready_count == 0 && wait_queue.empty() && next_arrival == total_processes &&
+               !admission_possible(current_time);
+    }
+
+    // everything tick() carries from one tick to the next, for checkpoints
+    void archive_state(state_archive &ar) override {
+        archive(ar, stride_queue);
+        archive_history(ar, ready_sequence);
+        archive(ar, pass);
+        archive(ar, global_pass);
+        archive(ar, lottery_queue);
+        archive(ar, rng);
+        archive(ar, ready_count);
+        archive(ar, wait_queue);
+        archive(ar, pending);
+        archive(ar, memory_freed);
+        archive(ar, running);
+        archive(ar, quantum_used);
+        archive_arrivals(ar, arrivals, next_arrival);
+        archive_history(ar, metrics);
+    }
+
+    std::string policy_signature() const override {
+        return std::string(config.policy == LOTTERY ? "LOTTERY " : "STRIDE ") + std::to_string(config.quantum) + " " + std::to_string(config.seed);
+    }
+
+    void tick() override {
+        // --- arrivals at this tick ---
+        admit_arrivals(arrivals, next_arrival, pending);
+
+        // Retry to assign memory for earlier arrivals that couldn't fit
+        retry_pending(pending, memory_freed);
+
+        // --- handle I/O completions scheduled for this tick ---
+        size_t i;
+        while (wait_queue.next_completion(current_time, i)) {
+            pass[i] = std::max(pass[i], global_pass);   // no credit for time spent blocked
+            transition(current_time, i, WAITING, READY);
+            make_ready(i);
+        }
+
+        // --- Scheduler dispatch if CPU idle ---
+        if (running == -1 && ready_count > 0) {
+            running = pick_next();
+            quantum_used = 0;
+            list_process[running].start_time = current_time;
+            transition(current_time, running, READY, RUNNING);
+        }
+
+        // --- page fault: this ms is spent trapping, the process waits for the page ---
+        // charged like CPU time, or a process faulting on every dispatch keeps the lowest pass (see scheduler_CFS);
+        // a lottery draw has no memory of past runs
+        if (running != -1 && page_fault(list_process[running], current_time)) {
+            if (config.policy == STRIDE) pass[running] += STRIDE1 / list_process[running].tickets;
+            transition(current_time + 1, running, RUNNING, WAITING);
+            wait_queue.submit(current_time + 1, -1, options.page_fault_time, running, list_process[running].PID);
+            running = -1;
+        }
+
+        // --- Execute one ms of CPU if running ---
+        if (running != -1) {
+            PCB &p = list_process[running];
+            p.remaining_time--;
+            quantum_used++;
+            pass[running] += STRIDE1 / p.tickets;
+
+            unsigned int executed_time = p.processing_time - p.remaining_time;
+            unsigned int transition_time = current_time + 1;
+
+            if (p.io_freq > 0 && executed_time > 0 && (executed_time % p.io_freq) == 0 && p.remaining_time > 0) {
+                transition(transition_time, running, RUNNING, WAITING);
+                wait_queue.submit(transition_time, p.device, p.io_duration, running, p.PID);
+                running = -1;
+            } else if (p.remaining_time == 0) {
+                transition(transition_time, running, RUNNING, TERMINATED);
+                free_memory(p, transition_time);
+                memory_freed = true;
+                terminated_count++;
+                running = -1;
+            } else if (quantum_used >= config.quantum && ready_count > 0) {
+                // quantum expired and someone else could win the CPU
+                transition(transition_time, running, RUNNING, READY);
+                make_ready(running);
+                running = -1;
+            }
+        }
+    }
+};
+
+std::unique_ptr<Simulator> make_stride_simulator(const std::vector<std::string> &args, const simulator_options &options) {
+    if (args.size() > 3) {
+        std::cerr << "Error: STRIDE takes at most 3 arguments: [stride|lottery] [quantum] [seed]" << std::endl;
+        return nullptr;
+    }
+
+    if (!swapping_supported("STRIDE", options)) return nullptr;
+
+    share_config config = {STRIDE, PS_DEFAULT_QUANTUM, PS_DEFAULT_SEED};
+    if (args.size() >= 1) {
+        if (args[0] == "lottery") config.policy = LOTTERY;
+        else if (args[0] != "stride") {
+            std::cerr << "Error: unknown policy " << args[0] << ", expected stride or lottery" << std::endl;
+            return nullptr;
+        }
+    }
+    if (args.size() >= 2 && !parse_number("STRIDE quantum", args[1], config.quantum, 1)) return nullptr;
+    if (args.size() == 3 && !parse_number("STRIDE seed", args[2], config.seed)) return nullptr;
+    return std::make_unique<stride_simulator>(config, options);
+}
@@ -0,0 +1,2722 @@
+#include "interrupts_101268848_101281787.hpp"
+
+//The OS side of the simulator and the helpers shared by every scheduling policy; built into the
+//simulator library together with the scheduler_<policy> sources.
+
+std::ostream& operator<<(std::ostream& os, const enum states& s) {
+
+	std::string state_names[] = {
+                                "NEW",
+                                "READY",
+                                "RUNNING",
+                                "WAITING",
+                                "TERMINATED",
+                                "NOT_ASSIGNED",
+                                "SUSP_READY",
+                                "SUSP_WAIT"
+    };
+    return (os << state_names[s]);
+}
+
+//---------------------------------------------CHECKPOINT ARCHIVE--------------------------------------------
+
+void archive(state_archive &ar, std::string &value) {
+    uint64_t n = value.size();
+    archive(ar, n);
+    if (ar.loading()) value.resize(n);
+    if (n > 0) ar.raw(&value[0], n);
+}
+
+void archive(state_archive &ar, std::vector<bool> &values) {
+    uint64_t n = values.size();
+    archive(ar, n);
+    if (ar.loading()) values.resize(n);
+    for (std::size_t i = 0; i < n; i++) {
+        bool bit = values[i];
+        archive(ar, bit);
+        values[i] = bit;
+    }
+}
+
+//A terminated process no longer influences the run, so a digest only keeps its PID and state
+void archive(state_archive &ar, PCB &process) {
+    if (ar.digest() && process.state == TERMINATED) {
+        archive(ar, process.PID);
+        archive(ar, process.state);
+        return;
+    }
+    ar.raw(&process, sizeof(PCB));
+}
+
+//------------------------------------HELPER FUNCTIONS FOR THE SIMULATOR------------------------------
+// Following function was taken from stackoverflow; helper function for splitting strings
+std::vector<std::string> split_delim(std::string input, std::string delim) {
+    std::vector<std::string> tokens;
+    std::size_t pos = 0;
+    std::string token;
+    while ((pos = input.find(delim)) != std::string::npos) {
+        token = input.substr(0, pos);
+        tokens.push_back(token);
+        input.erase(0, pos + delim.length());
+    }
+    tokens.push_back(input);
+
+    return tokens;
+}
+
+//Function that takes a queue as an input and outputs a string table of PCBs
+std::string print_PCB(std::vector<PCB> _PCB) {
+    const int tableWidth = 83;
+
+    std::stringstream buffer;
+    
+    // Print top border
+    buffer << "+" << std::setfill('-') << std::setw(tableWidth) << "+" << std::endl;
+    
+    // Print headers
+    buffer << "|"
+              << std::setfill(' ') << std::setw(4) << "PID"
+              << std::setw(2) << "|"
+              << std::setfill(' ') << std::setw(11) << "Partition"
+              << std::setw(2) << "|"
+              << std::setfill(' ') << std::setw(5) << "Size"
+              << std::setw(2) << "|"
+              << std::setfill(' ') << std::setw(13) << "Arrival Time"
+              << std::setw(2) << "|"
+              << std::setfill(' ') << std::setw(11) << "Start Time"
+              << std::setw(2) << "|"
+              << std::setfill(' ') << std::setw(14) << "Remaining Time"
+              << std::setw(2) << "|"
+              << std::setfill(' ') << std::setw(11) << "State"
+              << std::setw(2) << "|" << std::endl;
+    
+    // Print separator
+    buffer << "+" << std::setfill('-') << std::setw(tableWidth) << "+" << std::endl;
+    
+    // Print each PCB entry
+    for (const auto& program : _PCB) {
+        buffer << "|"
+                  << std::setfill(' ') << std::setw(4) << program.PID
+                  << std::setw(2) << "|"
+                  << std::setw(11) << program.partition_number
+                  << std::setw(2) << "|"
+                  << std::setw(5) << program.size
+                  << std::setw(2) << "|"
+                  << std::setw(13) << program.arrival_time
+                  << std::setw(2) << "|"
+                  << std::setw(11) << program.start_time
+                  << std::setw(2) << "|"
+                  << std::setw(14) << program.remaining_time
+                  << std::setw(2) << "|"
+                  << std::setw(11) << program.state
+                  << std::setw(2) << "|" << std::endl;
+    }
+    
+    // Print bottom border
+    buffer << "+" << std::setfill('-') << std::setw(tableWidth) << "+" << std::endl;
+
+    return buffer.str();
+}
+
+//Overloaded function that takes a single PCB as input
+std::string print_PCB(PCB _PCB) {
+    std::vector<PCB> temp;
+    temp.push_back(_PCB);
+    return print_PCB(temp);
+}
+
+std::string print_exec_header() {
+
+    const int tableWidth = 49;
+
+    std::stringstream buffer;
+    
+    // Print top border
+    buffer << "+" << std::setfill('-') << std::setw(tableWidth) << "+" << std::endl;
+    
+    // Print headers
+    buffer  << "|"
+            << std::setfill(' ') << std::setw(18) << "Time of Transition"
+            << std::setw(2) << "|"
+            << std::setfill(' ') << std::setw(3) << "PID"
+            << std::setw(2) << "|"
+            << std::setfill(' ') << std::setw(10) << "Old State"
+            << std::setw(2) << "|"
+            << std::setfill(' ') << std::setw(10) << "New State"
+            << std::setw(2) << "|" << std::endl;
+    
+    // Print separator
+    buffer << "+" << std::setfill('-') << std::setw(tableWidth) << "+" << std::endl;
+
+    return buffer.str();
+
+}
+
+std::string print_exec_status(unsigned int current_time, int PID, states old_state, states new_state) {
+
+    std::stringstream buffer;
+
+    buffer  << "|"
+            << std::setfill(' ') << std::setw(18) << current_time
+            << std::setw(2) << "|"
+            << std::setw(3) << PID
+            << std::setw(2) << "|"
+            << std::setw(10) << old_state
+            << std::setw(2) << "|"
+            << std::setw(10) << new_state
+            << std::setw(2) << "|" << std::endl;
+
+    return buffer.str();
+}
+
+std::string print_exec_footer() {
+    const int tableWidth = 49;
+    std::stringstream buffer;
+
+    // Print bottom border
+    buffer << "+" << std::setfill('-') << std::setw(tableWidth) << "+" << std::endl;
+
+    return buffer.str();
+}
+
+bool parse_exec_status(const std::string &line, unsigned int &time, int &PID, states &old_state, states &new_state) {
+    static const std::string state_names[] = {"NEW", "READY", "RUNNING", "WAITING", "TERMINATED", "NOT_ASSIGNED", "SUSP_READY", "SUSP_WAIT"};
+
+    // the four cells between the first five '|', trimmed; scanned in place, traces run to millions of rows
+    const char *cell[4], *cell_end[4];
+    size_t at = line.find('|');
+    for (int c = 0; c < 4; c++) {
+        if (at == std::string::npos) return false;
+        size_t next = line.find('|', at + 1);
+        if (next == std::string::npos) return false;
+        cell[c] = line.data() + at + 1;
+        cell_end[c] = line.data() + next;
+        while (cell[c] < cell_end[c] && *cell[c] == ' ') cell[c]++;
+        while (cell_end[c] > cell[c] && cell_end[c][-1] == ' ') cell_end[c]--;
+        at = next;
+    }
+    if (std::from_chars(cell[0], cell_end[0], time).ptr != cell_end[0] || cell[0] == cell_end[0]) return false;  // header row
+    if (std::from_chars(cell[1], cell_end[1], PID).ptr != cell_end[1] || cell[1] == cell_end[1]) return false;
+
+    int found = 0;
+    for (int s = NEW; s <= SUSPENDED_WAITING; s++) {
+        if (state_names[s].compare(0, std::string::npos, cell[2], cell_end[2] - cell[2]) == 0) { old_state = (states)s; found++; }
+        if (state_names[s].compare(0, std::string::npos, cell[3], cell_end[3] - cell[3]) == 0) { new_state = (states)s; found++; }
+    }
+    return found == 2;
+}
+
+//Synchronize the process in the process queue
+void sync_queue(std::vector<PCB> &process_queue, PCB _process) {
+    for(auto &process : process_queue) {
+        if(process.PID == _process.PID) {
+            process = _process;
+        }
+    }
+}
+
+//Writes a string to a file
+void write_output(std::string execution, const char* filename) {
+    std::ofstream output_file(filename);
+
+    bool written = output_file.is_open();
+    if (written) {
+        output_file << execution;
+        output_file.close();  // Close the file when done
+    }
+    report_output(written, filename);
+}
+
+void report_output(bool written, const char* filename) {
+    if (written) {
+        std::cout << "File content overwritten successfully." << std::endl;
+    } else {
+        std::cerr << "Error opening file!" << std::endl;
+    }
+
+    std::cout << "Output generated in " << filename << ".txt" << std::endl;
+}
+
+//-------------------------------------------METRICS FOR THE SIMULATOR-----------------------------------
+
+process_metrics init_metrics(const PCB &process) {
+    process_metrics metrics;
+    metrics.PID = process.PID;
+    metrics.arrival_time = process.arrival_time;
+    metrics.state = NOT_ASSIGNED;
+    metrics.last_transition = process.arrival_time;
+    metrics.response_time = -1;
+    metrics.finish_time = -1;
+    metrics.admission_time = 0;
+    metrics.ready_time = 0;
+    metrics.cpu_time = 0;
+    metrics.io_time = 0;
+    metrics.suspended_time = 0;
+    metrics.deadline = process.deadline > 0 ? process.arrival_time + process.deadline : 0;
+    return metrics;
+}
+
+//Charge the time since the last transition to the state being left, then enter new_state
+void track_transition(process_metrics &metrics, unsigned int current_time, states new_state) {
+    unsigned int elapsed = current_time - metrics.last_transition;
+    switch (metrics.state) {
+        case NEW:
+        case NOT_ASSIGNED:  metrics.admission_time += elapsed; break;
+        case READY:         metrics.ready_time += elapsed; break;
+        case RUNNING:       metrics.cpu_time += elapsed; break;
+        case WAITING:       metrics.io_time += elapsed; break;
+        case SUSPENDED_READY:
+        case SUSPENDED_WAITING: metrics.suspended_time += elapsed; break;
+        default: break;
+    }
+    if (new_state == RUNNING && metrics.response_time == -1) {
+        metrics.response_time = current_time - metrics.arrival_time;
+    }
+    if (new_state == TERMINATED) {
+        metrics.finish_time = current_time;
+    }
+    metrics.state = new_state;
+    metrics.last_transition = current_time;
+}
+
+//Table of per-process metrics followed by the averages over all processes.
+//CPU share is the fraction of the process's lifetime (arrival to exit) it spent running.
+//A run stopped early (time limit, wall limit, stall) leaves processes unterminated: they show "-" for turnaround,
+//response and CPU share, and turnaround, response, throughput and deadlines count the terminated ones only.
+std::string print_metrics(const std::vector<process_metrics> &metrics) {
+    const int tableWidth = 76;
+
+    std::stringstream buffer;
+    double total_turnaround = 0, total_ready = 0, total_response = 0, total_admission = 0, total_suspended = 0;
+    unsigned int makespan = 0, terminated = 0;
+
+    buffer << "+" << std::setfill('-') << std::setw(tableWidth) << "+" << std::endl;
+    buffer  << "|"
+            << std::setfill(' ') << std::setw(4) << "PID"
+            << std::setw(2) << "|"
+            << std::setw(11) << "Turnaround"
+            << std::setw(2) << "|"
+            << std::setw(9) << "Response"
+            << std::setw(2) << "|"
+            << std::setw(10) << "Admission"
+            << std::setw(2) << "|"
+            << std::setw(6) << "Ready"
+            << std::setw(2) << "|"
+            << std::setw(5) << "CPU"
+            << std::setw(2) << "|"
+            << std::setw(5) << "I/O"
+            << std::setw(2) << "|"
+            << std::setw(10) << "CPU Share"
+            << std::setw(2) << "|" << std::endl;
+    buffer << "+" << std::setfill('-') << std::setw(tableWidth) << "+" << std::endl;
+
+    for (const auto &m : metrics) {
+        bool finished = m.finish_time >= 0;
+        unsigned int turnaround = finished ? m.finish_time - m.arrival_time : 0;
+        double share = turnaround > 0 ? 100.0 * m.cpu_time / turnaround : 0.0;
+
+        total_ready += m.ready_time;
+        total_admission += m.admission_time;
+        total_suspended += m.suspended_time;
+        if (finished) {
+            terminated++;
+            total_turnaround += turnaround;
+            total_response += m.response_time;
+            makespan = std::max(makespan, (unsigned int)m.finish_time);
+        }
+
+        std::ostringstream share_text;
+        share_text << std::fixed << std::setprecision(2) << share << "%";
+        buffer  << "|"
+                << std::setfill(' ') << std::setw(4) << m.PID
+                << std::setw(2) << "|"
+                << std::setw(11) << (finished ? std::to_string(turnaround) : "-")
+                << std::setw(2) << "|"
+                << std::setw(9) << (finished ? std::to_string(m.response_time) : "-")
+                << std::setw(2) << "|"
+                << std::setw(10) << m.admission_time
+                << std::setw(2) << "|"
+                << std::setw(6) << m.ready_time
+                << std::setw(2) << "|"
+                << std::setw(5) << m.cpu_time
+                << std::setw(2) << "|"
+                << std::setw(5) << m.io_time
+                << std::setw(2) << "|"
+                << std::setw(10) << (finished ? share_text.str() : "-")
+                << std::setw(2) << "|" << std::endl;
+    }
+    buffer << "+" << std::setfill('-') << std::setw(tableWidth) << "+" << std::endl;
+
+    if (!metrics.empty()) {
+        double n = metrics.size(), done = std::max(terminated, 1u);
+        if (terminated < metrics.size()) buffer << "Terminated: " << terminated << "/" << metrics.size() << std::endl;
+        buffer << std::fixed << std::setprecision(2)
+               << "Average turnaround time: " << total_turnaround / done << std::endl
+               << "Average waiting time (ready): " << total_ready / n << std::endl
+               << "Average response time: " << total_response / done << std::endl
+               << "Average admission latency: " << total_admission / n << std::endl
+               << "Throughput: " << 1000.0 * terminated / std::max(makespan, 1u) << " processes/s" << std::endl;
+        if (total_suspended > 0) buffer << "Average time swapped out: " << total_suspended / n << std::endl;
+    }
+
+    latency_report latency = latency_from_metrics(metrics);
+    buffer << print_percentiles("Latency percentiles (ms):", {{"Waiting", &latency.waiting}, {"Response", &latency.response},
+                                                              {"Turnaround", &latency.turnaround}});
+
+    // Deadline accounting: lateness = finish - deadline, tardiness = max(lateness, 0)
+    const int lateness_limits[] = {0, 10, 100, 1000};
+    const char* lateness_labels[] = {"on time", "1-10 ms late", "11-100 ms late", "101-1000 ms late", ">1000 ms late"};
+    unsigned int lateness_buckets[5] = {0, 0, 0, 0, 0};
+    unsigned int with_deadline = 0, misses = 0, max_tardiness = 0;
+    double total_lateness = 0;
+
+    for (const auto &m : metrics) {
+        if (m.deadline == 0 || m.finish_time < 0) continue;
+        int lateness = m.finish_time - (int)m.deadline;
+        int bucket = 0;
+        while (bucket < 4 && lateness > lateness_limits[bucket]) bucket++;
+        lateness_buckets[bucket]++;
+        with_deadline++;
+        total_lateness += lateness;
+        if (lateness > 0) {
+            misses++;
+            max_tardiness = std::max(max_tardiness, (unsigned int)lateness);
+        }
+    }
+
+    if (with_deadline > 0) {
+        buffer << std::fixed << std::setprecision(2)
+               << "Deadline misses: " << misses << "/" << with_deadline
+               << " (" << 100.0 * misses / with_deadline << "%)" << std::endl
+               << "Average lateness: " << total_lateness / with_deadline << std::endl
+               << "Maximum tardiness: " << max_tardiness << std::endl
+               << "Lateness distribution:" << std::endl;
+        for (int i = 0; i < 5; i++) {
+            buffer << "  " << std::setfill(' ') << std::left << std::setw(18) << lateness_labels[i]
+                   << std::right << lateness_buckets[i] << std::endl;
+        }
+    }
+
+    return buffer.str();
+}
+
+latency_report latency_from_metrics(const std::vector<process_metrics> &metrics) {
+    latency_report report;
+    for (const auto &m : metrics) {
+        if (m.finish_time < 0) continue;
+        report.waiting.record(m.ready_time);
+        report.response.record(m.response_time);
+        report.turnaround.record(m.finish_time - m.arrival_time);
+    }
+    return report;
+}
+
+std::string print_percentiles(const std::string &title, const std::vector<std::pair<std::string, const latency_histogram*>> &rows) {
+    const int tableWidth = 76;
+    const double percentiles[] = {50, 90, 99, 99.9};
+
+    bool any = false;
+    for (auto &row : rows) any = any || row.second->count() > 0;
+    if (!any) return "";
+
+    std::stringstream buffer;
+    buffer << title << std::endl;
+    buffer << "+" << std::setfill('-') << std::setw(tableWidth) << "+" << std::endl;
+    buffer << "|" << std::setfill(' ') << std::setw(13) << "Latency"
+           << std::setw(2) << "|" << std::setw(9) << "Count"
+           << std::setw(2) << "|" << std::setw(8) << "p50"
+           << std::setw(2) << "|" << std::setw(8) << "p90"
+           << std::setw(2) << "|" << std::setw(8) << "p99"
+           << std::setw(2) << "|" << std::setw(8) << "p99.9"
+           << std::setw(2) << "|" << std::setw(8) << "Max"
+           << std::setw(2) << "|" << std::endl;
+    buffer << "+" << std::setfill('-') << std::setw(tableWidth) << "+" << std::endl;
+    for (auto &row : rows) {
+        const latency_histogram &h = *row.second;
+        if (h.count() == 0) continue;
+        buffer << "|" << std::setfill(' ') << std::setw(13) << row.first
+               << std::setw(2) << "|" << std::setw(9) << h.count();
+        for (double p : percentiles) buffer << std::setw(2) << "|" << std::setw(8) << h.value_at(p);
+        buffer << std::setw(2) << "|" << std::setw(8) << h.max()
+               << std::setw(2) << "|" << std::endl;
+    }
+    buffer << "+" << std::setfill('-') << std::setw(tableWidth) << "+" << std::endl;
+
+    return buffer.str();
+}
+
+std::string print_latency_report(const latency_report &report) {
+    return print_percentiles("Latency percentiles (ms):", {{"Waiting", &report.waiting}, {"Response", &report.response},
+                                                           {"Turnaround", &report.turnaround}, {"I/O queueing", &report.io_queueing}});
+}
+
+//Rebuild the metrics of a run from its execution table, for schedulers that only produce the trace
+std::vector<process_metrics> metrics_from_trace(const std::string &execution, const std::vector<PCB> &processes) {
+    std::vector<process_metrics> metrics;
+    std::unordered_map<int, size_t> index_of;
+    for (const auto &p : processes) {
+        index_of[p.PID] = metrics.size();
+        metrics.push_back(init_metrics(p));
+    }
+
+    std::istringstream lines(execution);
+    std::string line;
+    while (std::getline(lines, line)) {
+        unsigned int time;
+        int PID;
+        states old_state, new_state;
+        if (!parse_exec_status(line, time, PID, old_state, new_state) || index_of.count(PID) == 0) continue;
+        track_transition(metrics[index_of[PID]], time, new_state);
+    }
+
+    return metrics;
+}
+
+//--------------------------------------------FUNCTIONS FOR THE "OS"-------------------------------------
+
+void Simulator::add_hole(unsigned int address, unsigned int size) {
+    dynamic_partitions.holes[address] = size;
+    dynamic_partitions.holes_by_address.insert(address, size);
+    dynamic_partitions.holes_by_size.insert({size, address});
+}
+
+void Simulator::remove_hole(unsigned int address) {
+    auto it = dynamic_partitions.holes.find(address);
+    dynamic_partitions.holes_by_size.erase({it->second, address});
+    dynamic_partitions.holes_by_address.erase(address);
+    dynamic_partitions.holes.erase(it);
+}
+
+static unsigned int buddy_order(unsigned int size) {
+    unsigned int order = 0;
+    while ((1u << order) < size) order++;
+    return order;
+}
+
+//Reset the memory model; options.memory_size is rounded down to a power of two for the buddy allocator
+void Simulator::init_memory() {
+    std::copy(std::begin(DEFAULT_PARTITIONS), std::end(DEFAULT_PARTITIONS), memory_paritions);
+    dynamic_partitions = dynamic_memory();
+    memory_log.clear();
+    memory_requested = 0;
+    memory_allocated = 0;
+
+    if (options.memory_model == BUDDY) {
+        unsigned int top = 0;
+        while ((2u << top) <= options.memory_size) top++;
+        dynamic_partitions.buddy_free.resize(top + 1);
+        dynamic_partitions.buddy_free[top].insert(0);
+        dynamic_partitions.free = 1u << top;
+    } else if (options.memory_model == PAGED) {
+        paging = paged_memory();
+        paging.frame_owner.assign(options.frame_count, {-1, 0});
+        for (unsigned int frame = options.frame_count; frame > 0; frame--) paging.free_frames.push_back(frame - 1);
+        paging.load_stamp.assign(options.frame_count, 0);
+        paging.lru_position.resize(options.frame_count);
+        paging.referenced.assign(options.frame_count, false);
+        paging.pinned.assign(options.frame_count, false);
+    } else if (options.memory_model != FIXED_PARTITIONS) {
+        add_hole(0, options.memory_size);
+        dynamic_partitions.free = options.memory_size;
+    }
+}
+
+//Size of the largest unoccupied partition, 0 when every partition is taken
+unsigned int Simulator::largest_free_partition() const {
+    if (options.memory_model == FIXED_PARTITIONS) {
+        unsigned int largest = 0;
+        for(int i = 5; i >= 0; i--) {
+            if(memory_paritions[i].occupied == -1) {
+                largest = std::max(largest, memory_paritions[i].size);
+            }
+        }
+        return largest;
+    }
+    if (options.memory_model == PAGED) return paging.free_frames.size();
+    if (options.memory_model == BUDDY) {
+        for (int order = dynamic_partitions.buddy_free.size() - 1; order >= 0; order--) {
+            if (!dynamic_partitions.buddy_free[order].empty()) return 1u << order;
+        }
+        return 0;
+    }
+    return dynamic_partitions.holes_by_address.largest();
+}
+
+unsigned int Simulator::free_memory_total() const {
+    if (options.memory_model == PAGED) return paging.free_frames.size();
+    if (options.memory_model != FIXED_PARTITIONS) return dynamic_partitions.free;
+    unsigned int total = 0;
+    for (auto &partition : memory_paritions) {
+        if (partition.occupied == -1) total += partition.size;
+    }
+    return total;
+}
+
+void Simulator::log_memory(unsigned int current_time) {
+    memory_log.push_back({current_time, memory_requested, memory_allocated, free_memory_total(), largest_free_partition()});
+}
+
+//Carve a block for program out of the dynamic memory, returns its address or -1
+long Simulator::allocate_block(PCB &program) {
+    dynamic_memory &memory = dynamic_partitions;
+    unsigned int size = std::max(program.size, 1u);
+
+    if (options.memory_model == BUDDY) {
+        unsigned int order = buddy_order(size);
+        unsigned int available = order;
+        while (available < memory.buddy_free.size() && memory.buddy_free[available].empty()) available++;
+        if (available >= memory.buddy_free.size()) return -1;
+
+        unsigned int address = *memory.buddy_free[available].begin();
+        memory.buddy_free[available].erase(memory.buddy_free[available].begin());
+        while (available > order) {     // split, keeping the lower half
+            available--;
+            memory.buddy_free[available].insert(address + (1u << available));
+        }
+        memory.blocks[program.PID] = {address, 1u << order};
+        memory.free -= 1u << order;
+        return address;
+    }
+
+    long address = -1;
+    if (options.memory_model == FIRST_FIT) {
+        address = memory.holes_by_address.find(0, size);
+    } else if (options.memory_model == NEXT_FIT) {
+        address = memory.holes_by_address.find(memory.next_fit_rover, size);
+        if (address == -1) address = memory.holes_by_address.find(0, size);
+    } else {
+        auto best = memory.holes_by_size.lower_bound({size, 0});
+        if (best != memory.holes_by_size.end()) address = best->second;
+    }
+    if (address == -1) return -1;
+
+    unsigned int hole = memory.holes[address];
+    remove_hole(address);
+    if (hole > size) add_hole(address + size, hole - size);
+    memory.next_fit_rover = address + size;
+    memory.blocks[program.PID] = {(unsigned int)address, size};
+    memory.free -= size;
+    return address;
+}
+
+//Return the block of program to the dynamic memory, coalescing with free neighbours
+bool Simulator::release_block(PCB &program) {
+    dynamic_memory &memory = dynamic_partitions;
+    auto block = memory.blocks.find(program.PID);
+    if (block == memory.blocks.end()) return false;
+    unsigned int address = block->second.first;
+    unsigned int size = block->second.second;
+    memory.blocks.erase(block);
+    memory.free += size;
+
+    if (options.memory_model == BUDDY) {
+        unsigned int order = buddy_order(size);
+        while (order + 1 < memory.buddy_free.size()) {
+            unsigned int buddy = address ^ (1u << order);
+            auto it = memory.buddy_free[order].find(buddy);
+            if (it == memory.buddy_free[order].end()) break;
+            memory.buddy_free[order].erase(it);
+            address = std::min(address, buddy);
+            order++;
+        }
+        memory.buddy_free[order].insert(address);
+        return true;
+    }
+
+    auto next = memory.holes.lower_bound(address);
+    if (next != memory.holes.end() && next->first == address + size) {
+        size += next->second;
+        remove_hole(next->first);
+    }
+    auto previous = memory.holes.lower_bound(address);
+    if (previous != memory.holes.begin()) {
+        --previous;
+        if (previous->first + previous->second == address) {
+            address = previous->first;
+            size += previous->second;
+            remove_hole(address);
+        }
+    }
+    add_hole(address, size);
+    return true;
+}
+
+//Page touched by the ms of CPU a process is about to run. Deterministic: 90% of references fall in
+//a 4-page working set that moves every 50 ms of CPU, the rest anywhere in the address space.
+unsigned int referenced_page(const PCB &program) {
+    unsigned int executed_time = program.processing_time - program.remaining_time;
+    uint64_t hash = ((uint64_t)program.PID << 32) ^ executed_time;
+    hash += 0x9e3779b97f4a7c15ull;                          // splitmix64 finalizer
+    hash = (hash ^ (hash >> 30)) * 0xbf58476d1ce4e5b9ull;
+    hash = (hash ^ (hash >> 27)) * 0x94d049bb133111ebull;
+    hash ^= hash >> 31;
+
+    unsigned int pages = std::max(program.size, 1u);
+    if (hash % 10 == 0) return (hash >> 8) % pages;
+    unsigned int window = (executed_time / 50) * 4;
+    return (window + (hash >> 8) % 4) % pages;
+}
+
+void Simulator::tlb_insert(uint64_t key) {
+    if (options.tlb_size == 0) return;
+    if (paging.tlb.size() == options.tlb_size) {
+        paging.tlb_index.erase(paging.tlb.back());
+        paging.tlb.pop_back();
+    }
+    paging.tlb.push_front(key);
+    paging.tlb_index[key] = paging.tlb.begin();
+}
+
+void Simulator::tlb_erase(uint64_t key) {
+    auto it = paging.tlb_index.find(key);
+    if (it == paging.tlb_index.end()) return;
+    paging.tlb.erase(it->second);
+    paging.tlb_index.erase(it);
+}
+
+//Pick a victim frame with the configured policy and unmap the page in it. Frames loaded for a process
+//that has not run since are pinned, otherwise processes could steal each other's pages forever;
+//returns -1 when every frame is pinned.
+long Simulator::evict_frame() {
+    long frame = -1;
+    if (options.replacement_policy == FIFO_REPLACEMENT) {
+        for (size_t scanned = paging.fifo.size(); scanned > 0 && frame == -1; scanned--) {
+            auto oldest = paging.fifo.front();
+            paging.fifo.pop_front();
+            // entries of frames freed by an exit since they were loaded are stale
+            if (paging.frame_owner[oldest.first].first == -1 || paging.load_stamp[oldest.first] != oldest.second) continue;
+            if (paging.pinned[oldest.first]) paging.fifo.push_back(oldest);
+            else frame = oldest.first;
+        }
+    } else if (options.replacement_policy == LRU_REPLACEMENT) {
+        for (auto it = paging.lru.rbegin(); it != paging.lru.rend(); ++it) {
+            if (paging.pinned[*it]) continue;
+            frame = *it;
+            paging.lru.erase(std::next(it).base());
+            break;
+        }
+    } else {
+        for (unsigned int scanned = 0; scanned < 2 * options.frame_count && frame == -1; scanned++) {
+            unsigned int hand = paging.clock_hand;
+            paging.clock_hand = (paging.clock_hand + 1) % options.frame_count;
+            if (paging.pinned[hand]) continue;
+            if (paging.referenced[hand]) paging.referenced[hand] = false;
+            else frame = hand;
+        }
+    }
+    if (frame == -1) return -1;
+
+    auto owner = paging.frame_owner[frame];
+    paging.page_tables[owner.first][owner.second] = -1;
+    tlb_erase(((uint64_t)owner.first << 32) | owner.second);
+    paging.evictions++;
+    return frame;
+}
+
+//Simulate the memory reference of the next ms of program. Returns true on a page fault, in which case
+//the page is loaded (evicting a victim if possible) and the process has to wait options.page_fault_time ms.
+bool Simulator::page_fault(const PCB &program, unsigned int current_time) {
+    if (options.memory_model != PAGED) return false;
+
+    auto table = paging.page_tables.find(program.PID);
+    if (table == paging.page_tables.end()) return false;    // no address space (not admitted)
+
+    unsigned int page = referenced_page(program);
+    uint64_t key = ((uint64_t)program.PID << 32) | page;
+    std::vector<int> &page_table = table->second;
+    paging.references++;
+
+    int frame = page_table[page];
+    if (paging.tlb_index.count(key)) {
+        paging.tlb_hits++;
+        paging.tlb.splice(paging.tlb.begin(), paging.tlb, paging.tlb_index[key]);
+    } else if (frame != -1) {
+        tlb_insert(key);    // TLB miss, page table walk hits
+    }
+
+    if (frame != -1) {      // resident: record the use for LRU/CLOCK
+        paging.pinned[frame] = false;
+        if (options.replacement_policy == LRU_REPLACEMENT) {
+            paging.lru.splice(paging.lru.begin(), paging.lru, paging.lru_position[frame]);
+        }
+        paging.referenced[frame] = true;
+        return false;
+    }
+
+    paging.page_faults++;
+    long victim;
+    if (!paging.free_frames.empty()) {
+        victim = paging.free_frames.back();
+        paging.free_frames.pop_back();
+        memory_allocated++;
+    } else {
+        victim = evict_frame();
+        if (victim == -1) return true;  // no frame can be taken yet, retry after the fault service time
+    }
+
+    paging.frame_owner[victim] = {program.PID, page};
+    page_table[page] = victim;
+    paging.load_stamp[victim] = paging.next_stamp++;
+    paging.fifo.push_back({victim, paging.load_stamp[victim]});
+    if (options.replacement_policy == LRU_REPLACEMENT) {
+        paging.lru.push_front(victim);
+        paging.lru_position[victim] = paging.lru.begin();
+    }
+    paging.referenced[victim] = true;
+    paging.pinned[victim] = true;
+    tlb_insert(key);
+    log_memory(current_time);
+    return true;
+}
+
+//Release every frame and TLB entry of an exiting process
+void Simulator::release_pages(const PCB &program) {
+    auto table = paging.page_tables.find(program.PID);
+    if (table == paging.page_tables.end()) return;
+    for (unsigned int page = 0; page < table->second.size(); page++) {
+        int frame = table->second[page];
+        if (frame == -1) continue;
+        paging.frame_owner[frame] = {-1, 0};
+        paging.free_frames.push_back(frame);
+        paging.referenced[frame] = false;
+        paging.pinned[frame] = false;
+        if (options.replacement_policy == LRU_REPLACEMENT) paging.lru.erase(paging.lru_position[frame]);
+        tlb_erase(((uint64_t)program.PID << 32) | page);
+        memory_allocated--;
+    }
+    paging.page_tables.erase(table);
+}
+
+//Assign memory partition to program
+bool Simulator::assign_memory(PCB &program, unsigned int current_time) {
+    if (options.memory_model == PAGED) {
+        // demand paging: admission only creates the page table, frames are loaded on faults
+        paging.page_tables[program.PID].assign(std::max(program.size, 1u), -1);
+        program.partition_number = 0;
+        memory_requested += program.size;
+        log_memory(current_time);
+        if (trace_store) trace_store->partition(current_time, program.PID, program.partition_number);
+        return true;
+    }
+    if (options.memory_model != FIXED_PARTITIONS) {
+        long address = allocate_block(program);
+        if (address == -1) return false;
+        program.partition_number = address;
+        memory_requested += program.size;
+        memory_allocated += dynamic_partitions.blocks[program.PID].second;
+        log_memory(current_time);
+        if (trace_store) trace_store->partition(current_time, program.PID, program.partition_number);
+        return true;
+    }
+
+    int size_to_fit = program.size;
+    int available_size = 0;
+
+    for(int i = 5; i >= 0; i--) {
+        available_size = memory_paritions[i].size;
+
+        if(size_to_fit <= available_size && memory_paritions[i].occupied == -1) {
+            memory_paritions[i].occupied = program.PID;
+            program.partition_number = memory_paritions[i].partition_number;
+            memory_requested += program.size;
+            memory_allocated += memory_paritions[i].size;
+            log_memory(current_time);
+            if (trace_store) trace_store->partition(current_time, program.PID, program.partition_number);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+//Free a memory partition
+bool Simulator::free_memory(PCB &program, unsigned int current_time) {
+    if (options.memory_model == PAGED) {
+        if (paging.page_tables.count(program.PID) == 0) return false;
+        release_pages(program);
+        program.partition_number = -1;
+        memory_requested -= program.size;
+        log_memory(current_time);
+        if (trace_store) trace_store->partition(current_time, program.PID, program.partition_number);
+        return true;
+    }
+    if (options.memory_model != FIXED_PARTITIONS) {
+        unsigned int allocated = dynamic_partitions.blocks.count(program.PID) ? dynamic_partitions.blocks[program.PID].second : 0;
+        if (!release_block(program)) return false;
+        program.partition_number = -1;
+        memory_requested -= program.size;
+        memory_allocated -= allocated;
+        log_memory(current_time);
+        if (trace_store) trace_store->partition(current_time, program.PID, program.partition_number);
+        return true;
+    }
+
+    for(int i = 5; i >= 0; i--) {
+        if(program.PID == memory_paritions[i].occupied) {
+            memory_paritions[i].occupied = -1;
+            program.partition_number = -1;
+            memory_requested -= program.size;
+            memory_allocated -= memory_paritions[i].size;
+            log_memory(current_time);
+            if (trace_store) trace_store->partition(current_time, program.PID, program.partition_number);
+            return true;
+        }
+    }
+    return false;
+}
+
+//Memory utilization over time followed by fragmentation averages.
+//External fragmentation is the share of free memory that is not in the largest hole.
+std::string Simulator::print_memory_log() const {
+    const int tableWidth = 73;
+
+    std::stringstream buffer;
+    double total_external = 0, worst_external = 0, total_internal = 0;
+
+    buffer << "+" << std::setfill('-') << std::setw(tableWidth) << "+" << std::endl;
+    buffer  << "|"
+            << std::setfill(' ') << std::setw(10) << "Time"
+            << std::setw(2) << "|"
+            << std::setw(10) << "Requested"
+            << std::setw(2) << "|"
+            << std::setw(10) << "Allocated"
+            << std::setw(2) << "|"
+            << std::setw(8) << "Free"
+            << std::setw(2) << "|"
+            << std::setw(13) << "Largest Free"
+            << std::setw(2) << "|"
+            << std::setw(10) << "Ext. Frag"
+            << std::setw(2) << "|" << std::endl;
+    buffer << "+" << std::setfill('-') << std::setw(tableWidth) << "+" << std::endl;
+
+    for (const auto &sample : memory_log) {
+        double external = sample.free > 0 ? 100.0 * (sample.free - sample.largest_free) / sample.free : 0.0;
+        double internal = sample.allocated > 0 ? 100.0 * (sample.allocated - sample.requested) / sample.allocated : 0.0;
+        total_external += external;
+        total_internal += internal;
+        worst_external = std::max(worst_external, external);
+
+        buffer  << "|"
+                << std::setfill(' ') << std::setw(10) << sample.time
+                << std::setw(2) << "|"
+                << std::setw(10) << sample.requested
+                << std::setw(2) << "|"
+                << std::setw(10) << sample.allocated
+                << std::setw(2) << "|"
+                << std::setw(8) << sample.free
+                << std::setw(2) << "|"
+                << std::setw(13) << sample.largest_free
+                << std::setw(2) << "|"
+                << std::setw(9) << std::fixed << std::setprecision(2) << external << "%"
+                << std::setw(2) << "|" << std::endl;
+    }
+    buffer << "+" << std::setfill('-') << std::setw(tableWidth) << "+" << std::endl;
+
+    if (!memory_log.empty()) {
+        double n = memory_log.size();
+        buffer << std::fixed << std::setprecision(2)
+               << "Average external fragmentation: " << total_external / n << "%" << std::endl
+               << "Worst external fragmentation: " << worst_external << "%" << std::endl
+               << "Average internal fragmentation: " << total_internal / n << "%" << std::endl;
+    }
+
+    if (options.memory_model == PAGED) {
+        double references = std::max(paging.references, 1ul);
+        buffer << std::fixed << std::setprecision(2)
+               << "Frames: " << options.frame_count << ", TLB entries: " << options.tlb_size << std::endl
+               << "Memory references: " << paging.references << std::endl
+               << "TLB hit rate: " << 100.0 * paging.tlb_hits / references << "%" << std::endl
+               << "Page faults: " << paging.page_faults
+               << " (" << 100.0 * paging.page_faults / references << "% of references)" << std::endl
+               << "Evictions: " << paging.evictions << std::endl;
+    }
+
+    return buffer.str();
+}
+
+//---------------------------------------------I/O DEVICES---------------------------------------------
+
+//Parse "<name>[:<slots>[:fifo|elevator]]" and append the device
+bool add_device(simulator_options &options, const std::string &spec) {
+    auto fields = split_delim(spec, ":");
+    io_device device = {};
+    device.name = fields[0];
+    device.slots = 1;
+    if (fields.size() > 1 && !parse_number("--device slots", fields[1], device.slots)) return false;
+    device.upward = true;
+    if (fields.size() > 2 && fields[2] == "elevator") device.elevator = true;
+    else if (fields.size() > 2 && fields[2] != "fifo") {
+        std::cerr << "Error: unknown I/O queue discipline " << fields[2] << ", expected fifo or elevator" << std::endl;
+        return false;
+    }
+    if (device.name.empty() || device.slots == 0) {
+        std::cerr << "Error: a device needs a name and at least one slot" << std::endl;
+        return false;
+    }
+    options.devices.push_back(device);
+    return true;
+}
+
+void Simulator::init_devices() {
+    io_devices.clear();
+    for (auto &configured : options.devices) {
+        io_device device = {};
+        device.name = configured.name;
+        device.slots = configured.slots;
+        device.elevator = configured.elevator;
+        device.upward = true;
+        io_devices.push_back(device);
+    }
+    io_horizon = 0;
+}
+
+//Track an I/O request goes to: deterministic in (PID, request number), like referenced_page
+unsigned int io_track(int PID, unsigned long request) {
+    uint64_t hash = ((uint64_t)(uint32_t)PID << 32) ^ request;
+    hash += 0x9e3779b97f4a7c15ull;
+    hash = (hash ^ (hash >> 30)) * 0xbf58476d1ce4e5b9ull;
+    hash = (hash ^ (hash >> 27)) * 0x94d049bb133111ebull;
+    hash ^= hash >> 31;
+    return hash % IO_TRACKS;
+}
+
+//Per-device utilization, queue depth and queueing delay of the last run
+std::string Simulator::print_device_stats() const {
+    const int tableWidth = 79;
+
+    std::stringstream buffer;
+    buffer << "+" << std::setfill('-') << std::setw(tableWidth) << "+" << std::endl;
+    buffer << "|" << std::setfill(' ') << std::setw(10) << "Device"
+           << std::setw(2) << "|" << std::setw(9) << "Requests"
+           << std::setw(2) << "|" << std::setw(12) << "Utilization"
+           << std::setw(2) << "|" << std::setw(10) << "Avg Depth"
+           << std::setw(2) << "|" << std::setw(10) << "Max Depth"
+           << std::setw(2) << "|" << std::setw(17) << "Avg Queue Delay"
+           << std::setw(2) << "|" << std::endl;
+    buffer << "+" << std::setfill('-') << std::setw(tableWidth) << "+" << std::endl;
+    for (auto &d : io_devices) {
+        double span = std::max(io_horizon, 1u);
+        double utilization = 100.0 * d.busy_time / (span * d.slots);
+        double depth = (d.depth_area + (uint64_t)d.queue.size() * (io_horizon - std::min(d.last_change, io_horizon))) / span;
+        double delay = d.requests > 0 ? (double)d.queueing_delay / d.requests : 0;
+        buffer << "|" << std::setfill(' ') << std::setw(10) << d.name
+               << std::setw(2) << "|" << std::setw(9) << d.requests
+               << std::setw(2) << "|" << std::setw(11) << std::fixed << std::setprecision(2) << std::min(utilization, 100.0) << "%"
+               << std::setw(2) << "|" << std::setw(10) << depth
+               << std::setw(2) << "|" << std::setw(10) << d.max_depth
+               << std::setw(2) << "|" << std::setw(17) << delay
+               << std::setw(2) << "|" << std::endl;
+    }
+    buffer << "+" << std::setfill('-') << std::setw(tableWidth) << "+" << std::endl;
+
+    std::vector<std::pair<std::string, const latency_histogram*>> delays;
+    for (auto &d : io_devices) delays.push_back({d.name, &d.queueing_delays});
+    buffer << print_percentiles("Queue delay percentiles (ms):", delays);
+
+    return buffer.str();
+}
+
+int parse_simulator_options(int argc, char** argv, simulator_options &options) {
+    int kept = 1;
+    options.run_signature = std::filesystem::path(argv[0]).filename().string();
+    for (int i = 1; i < argc; i++) {
+        std::string option = argv[i];
+        // options that only control checkpointing, limits and caching may change between a run and its resume
+        bool run_option = option.rfind("--checkpoint", 0) != 0 && option.rfind("--resume=", 0) != 0 &&
+                          option.rfind("--time-limit=", 0) != 0 && option.rfind("--wall-limit=", 0) != 0 &&
+                          option.rfind("--cache", 0) != 0;
+        if (run_option) options.run_signature += " " + option;
+        if (option.rfind("--memory=", 0) == 0) {
+            std::string model = option.substr(9);
+            if (model == "fixed") options.memory_model = FIXED_PARTITIONS;
+            else if (model == "first-fit") options.memory_model = FIRST_FIT;
+            else if (model == "best-fit") options.memory_model = BEST_FIT;
+            else if (model == "next-fit") options.memory_model = NEXT_FIT;
+            else if (model == "buddy") options.memory_model = BUDDY;
+            else if (model == "paged") options.memory_model = PAGED;
+            else {
+                std::cerr << "Error: unknown memory model " << model << std::endl;
+                return -1;
+            }
+        } else if (option.rfind("--memory-size=", 0) == 0) {
+            if (!parse_number("--memory-size", option.substr(14), options.memory_size)) return -1;
+            if (options.memory_size == 0) {
+                std::cerr << "Error: memory size must be positive" << std::endl;
+                return -1;
+            }
+        } else if (option.rfind("--frames=", 0) == 0) {
+            if (!parse_number("--frames", option.substr(9), options.frame_count)) return -1;
+            if (options.frame_count == 0) {
+                std::cerr << "Error: frame count must be positive" << std::endl;
+                return -1;
+            }
+        } else if (option.rfind("--tlb-size=", 0) == 0) {
+            if (!parse_number("--tlb-size", option.substr(11), options.tlb_size)) return -1;
+        } else if (option.rfind("--page-fault-time=", 0) == 0) {
+            if (!parse_number("--page-fault-time", option.substr(18), options.page_fault_time)) return -1;
+        } else if (option == "--swap") {
+            options.swapping_enabled = true;
+        } else if (option.rfind("--swap-out-time=", 0) == 0) {
+            if (!parse_number("--swap-out-time", option.substr(16), options.swap_out_time)) return -1;
+        } else if (option.rfind("--swap-in-time=", 0) == 0) {
+            if (!parse_number("--swap-in-time", option.substr(15), options.swap_in_time)) return -1;
+        } else if (option.rfind("--device=", 0) == 0) {
+            if (!add_device(options, option.substr(9))) return -1;
+        } else if (option.rfind("--checkpoint=", 0) == 0) {
+            options.checkpoint_path = option.substr(13);
+        } else if (option.rfind("--checkpoint-interval=", 0) == 0) {
+            if (!parse_number("--checkpoint-interval", option.substr(22), options.checkpoint_interval)) return -1;
+            if (options.checkpoint_interval == 0) {
+                std::cerr << "Error: checkpoint interval must be positive" << std::endl;
+                return -1;
+            }
+        } else if (option.rfind("--resume=", 0) == 0) {
+            options.resume_path = option.substr(9);
+        } else if (option.rfind("--what-if=", 0) == 0) {
+            auto fields = split_delim(option.substr(10), ":");
+            options.what_if.active = true;
+            if (!parse_number("--what-if PID", fields[0], options.what_if.PID)) return -1;
+            for (size_t f = 1; f < fields.size(); f++) {
+                auto assignment = split_delim(fields[f], "=");
+                if (assignment.size() != 2 || std::find(WHAT_IF_FIELDS.begin(), WHAT_IF_FIELDS.end(), assignment[0]) == WHAT_IF_FIELDS.end()) {
+                    std::cerr << "Error: bad what-if change " << fields[f] << ", expected <field>=<value> with field one of"
+                              << " size, arrival, burst, io-freq, io-duration, nice, deadline, tickets, device" << std::endl;
+                    return -1;
+                }
+                // every field but nice is unsigned in the PCB
+                int nice = 0;
+                unsigned int number = 0;
+                bool parsed = assignment[0] == "nice" ? parse_number("--what-if nice", assignment[1], nice, -20)
+                                                      : parse_number("--what-if " + assignment[0], assignment[1], number);
+                if (!parsed) return -1;
+                options.what_if.fields.push_back({assignment[0], assignment[0] == "nice" ? (long)nice : (long)number});
+            }
+        } else if (option.rfind("--time-limit=", 0) == 0) {
+            if (!parse_number("--time-limit", option.substr(13), options.time_limit)) return -1;
+        } else if (option.rfind("--wall-limit=", 0) == 0) {
+            if (!parse_number("--wall-limit", option.substr(13), options.wall_limit)) return -1;
+        } else if (option.rfind("--cache=", 0) == 0) {
+            options.cache_path = option.substr(8);
+        } else if (option.rfind("--cache-size=", 0) == 0) {
+            unsigned int megabytes;
+            if (!parse_number("--cache-size", option.substr(13), megabytes)) return -1;
+            options.cache_size = (uint64_t)megabytes << 20;
+        } else if (option.rfind("--trace-index=", 0) == 0) {
+            options.trace_index_path = option.substr(14);
+        } else if (option.rfind("--index-interval=", 0) == 0) {
+            if (!parse_number("--index-interval", option.substr(17), options.index_interval)) return -1;
+            if (options.index_interval == 0) {
+                std::cerr << "Error: index interval must be positive" << std::endl;
+                return -1;
+            }
+        } else if (option.rfind("--sample-interval=", 0) == 0) {
+            if (!parse_number("--sample-interval", option.substr(18), options.sample_interval)) return -1;
+        } else if (option.rfind("--sample-rows=", 0) == 0) {
+            if (!parse_number("--sample-rows", option.substr(14), options.sample_rows)) return -1;
+            if (options.sample_rows < 2) {
+                std::cerr << "Error: load samples need at least 2 rows" << std::endl;
+                return -1;
+            }
+        } else if (option.rfind("--replacement=", 0) == 0) {
+            std::string policy = option.substr(14);
+            if (policy == "fifo") options.replacement_policy = FIFO_REPLACEMENT;
+            else if (policy == "lru") options.replacement_policy = LRU_REPLACEMENT;
+            else if (policy == "clock") options.replacement_policy = CLOCK_REPLACEMENT;
+            else {
+                std::cerr << "Error: unknown replacement policy " << policy << std::endl;
+                return -1;
+            }
+        } else {
+            argv[kept++] = argv[i];
+        }
+    }
+    if (options.what_if.active && (!options.checkpoint_path.empty() || !options.resume_path.empty())) {
+        std::cerr << "Error: --what-if cannot be combined with --checkpoint or --resume" << std::endl;
+        return -1;
+    }
+    if (!options.trace_index_path.empty() && (options.what_if.active || !options.resume_path.empty())) {
+        // the store is written as the run goes, from the start
+        std::cerr << "Error: --trace-index cannot be combined with --what-if or --resume" << std::endl;
+        return -1;
+    }
+    if (options.what_if.active && options.sample_interval > 0) {
+        // the changed run splices in the end of the original, which has no samples to splice
+        std::cerr << "Error: --what-if cannot be combined with --sample-interval" << std::endl;
+        return -1;
+    }
+    return kept;
+}
+
+//Size of the partition or block currently held by program, 0 if it holds none
+unsigned int Simulator::allocated_size(const PCB &program) const {
+    if (options.memory_model == FIXED_PARTITIONS) {
+        for (auto &partition : memory_paritions) {
+            if (partition.occupied == program.PID) return partition.size;
+        }
+        return 0;
+    }
+    auto block = dynamic_partitions.blocks.find(program.PID);
+    return block == dynamic_partitions.blocks.end() ? 0 : block->second.second;
+}
+
+//-------------------------------------MEDIUM-TERM SCHEDULER (SWAPPING)----------------------------------
+
+void set_state(std::vector<PCB> &list_process, int PID, states state) {
+    for (auto &p : list_process) if (p.PID == PID) p.state = state;
+}
+
+bool swapping_supported(const std::string &policy, const simulator_options &options) {
+    if (!options.swapping_enabled) return true;
+    std::cerr << "Error: " << policy << " does not swap, --swap only works with RR, EP and EP_RR" << std::endl;
+    return false;
+}
+
+//I/O of a swapped-out process finished: SUSPENDED_WAITING -> SUSPENDED_READY
+void Simulator::suspended_io_done(swap_space &swap, const PCB &process, unsigned int now) {
+    emit(now, process.PID, SUSPENDED_WAITING, SUSPENDED_READY);
+    set_state(list_process, process.PID, SUSPENDED_READY);
+    bool writing = false;
+    for (auto &t : swap.swapping_out) if (t.PID == process.PID) writing = true;
+    if (!writing) swap.suspended.push_back(process.PID);  // otherwise queued when the swap-out completes
+}
+
+//One tick of the medium-term scheduler. When a process that has arrived cannot get memory, a WAITING
+//process (or a READY one with a lower priority, i.e. a larger PID) holding a big enough partition is
+//swapped out and its memory handed to the pending process. Suspended processes are swapped back in
+//FIFO as soon as memory is free. One transfer in each direction is in flight at a time.
+void Simulator::medium_term_scheduler(swap_space &swap, std::vector<PCB> &ready_queue, wait_list &wait_queue, unsigned int now) {
+    if (!options.swapping_enabled || options.memory_model == PAGED) return;
+
+    // swap-outs finishing now release the victim's memory straight to the process they were started for
+    for (auto it = swap.swapping_out.begin(); it != swap.swapping_out.end();) {
+        if (it->done_time != now) { ++it; continue; }
+        for (auto &p : list_process) {
+            if (p.PID != it->PID) continue;
+            free_memory(p, now);
+            if (p.state == SUSPENDED_READY) swap.suspended.push_back(p.PID);
+        }
+        for (auto &w : wait_queue) if (w.second.first.PID == it->PID) w.second.first.partition_number = -1;
+        for (auto &p : list_process) {
+            if (p.PID == it->target && p.state == NOT_ASSIGNED && assign_memory(p, now)) {
+                p.state = READY;
+                ready_queue.push_back(p);
+                emit(now, p.PID, NEW, READY);
+            }
+        }
+        it = swap.swapping_out.erase(it);
+    }
+
+    // swap-ins finishing now
+    for (auto it = swap.swapping_in.begin(); it != swap.swapping_in.end();) {
+        if (it->done_time != now) { ++it; continue; }
+        for (auto &p : list_process) {
+            if (p.PID != it->PID) continue;
+            p.state = READY;
+            ready_queue.push_back(p);
+            emit(now, p.PID, SUSPENDED_READY, READY);
+        }
+        it = swap.swapping_in.erase(it);
+    }
+
+    // start a swap-in if memory is available for the oldest suspended process
+    if (swap.swapping_in.empty() && !swap.suspended.empty()) {
+        for (auto &p : list_process) {
+            if (p.PID == swap.suspended.front() && assign_memory(p, now)) {
+                swap.swapping_in.push_back({p.PID, now + options.swap_in_time, -1});
+                swap.suspended.erase(swap.suspended.begin());
+                break;
+            }
+        }
+    }
+
+    // start a swap-out for the first pending arrival that can be helped
+    if (!swap.swapping_out.empty()) return;
+    for (auto &pending : list_process) {
+        if (pending.state != NOT_ASSIGNED || pending.arrival_time > now) continue;
+
+        int victim = -1;
+        unsigned int latest_completion = 0;
+        for (auto &entry : wait_queue) {
+            auto &w = entry.second;
+            if (w.first.state == WAITING && allocated_size(w.first) >= pending.size && (victim == -1 || w.second > latest_completion)) {
+                victim = w.first.PID;
+                latest_completion = w.second;
+            }
+        }
+        if (victim != -1) {
+            for (auto &w : wait_queue) if (w.second.first.PID == victim) w.second.first.state = SUSPENDED_WAITING;
+            set_state(list_process, victim, SUSPENDED_WAITING);
+            emit(now, victim, WAITING, SUSPENDED_WAITING);
+        } else {
+            auto lowest = ready_queue.end();
+            for (auto it = ready_queue.begin(); it != ready_queue.end(); ++it) {
+                if (it->PID > pending.PID && allocated_size(*it) >= pending.size && (lowest == ready_queue.end() || it->PID > lowest->PID)) {
+                    lowest = it;
+                }
+            }
+            if (lowest == ready_queue.end()) continue;
+            victim = lowest->PID;
+            ready_queue.erase(lowest);
+            set_state(list_process, victim, SUSPENDED_READY);
+            emit(now, victim, READY, SUSPENDED_READY);
+        }
+
+        swap.swapping_out.push_back({victim, now + options.swap_out_time, pending.PID});
+        return;
+    }
+}
+
+//--------------------------------------------CHECKPOINTS----------------------------------------------
+
+void archive(state_archive &ar, swap_space &swap) {
+    archive(ar, swap.swapping_out);
+    archive(ar, swap.swapping_in);
+    archive(ar, swap.suspended);
+}
+
+//The hole trees are rebuilt from the hole map rather than stored
+void archive(state_archive &ar, dynamic_memory &memory) {
+    archive(ar, memory.holes);
+    archive(ar, memory.next_fit_rover);
+    archive(ar, memory.buddy_free);
+    archive(ar, memory.blocks);
+    archive(ar, memory.free);
+    if (ar.loading()) {
+        memory.holes_by_address = free_block_tree();
+        memory.holes_by_size.clear();
+        for (auto &hole : memory.holes) {
+            memory.holes_by_address.insert(hole.first, hole.second);
+            memory.holes_by_size.insert({hole.second, hole.first});
+        }
+    }
+}
+
+//The LRU positions and TLB index point into their lists, so they are rebuilt from the list order
+void archive(state_archive &ar, paged_memory &memory) {
+    archive(ar, memory.frame_owner);
+    archive(ar, memory.free_frames);
+    archive(ar, memory.page_tables);
+    archive(ar, memory.fifo);
+    archive(ar, memory.load_stamp);
+    archive(ar, memory.next_stamp);
+    archive(ar, memory.lru);
+    archive(ar, memory.referenced);
+    archive(ar, memory.pinned);
+    archive(ar, memory.clock_hand);
+    archive(ar, memory.tlb);
+    archive_history(ar, memory.references);
+    archive_history(ar, memory.tlb_hits);
+    archive_history(ar, memory.page_faults);
+    archive_history(ar, memory.evictions);
+    if (ar.loading()) {
+        memory.lru_position.assign(memory.frame_owner.size(), memory.lru.end());
+        for (auto it = memory.lru.begin(); it != memory.lru.end(); ++it) memory.lru_position[*it] = it;
+        memory.tlb_index.clear();
+        for (auto it = memory.tlb.begin(); it != memory.tlb.end(); ++it) memory.tlb_index[*it] = it;
+    }
+}
+
+//Everything outside the scheduler: the memory model, the memory log and the device statistics
+void Simulator::archive_os_state(state_archive &ar) {
+    for (auto &partition : memory_paritions) archive(ar, partition.occupied);
+    archive(ar, dynamic_partitions);
+    archive(ar, paging);
+    archive(ar, memory_requested);
+    archive(ar, memory_allocated);
+    archive_history(ar, memory_log);
+    for (auto &d : io_devices) {
+        archive(ar, d.requests);    // also seeds the elevator tracks
+        archive_history(ar, d.busy_time);
+        archive_history(ar, d.queueing_delay);
+        archive_history(ar, d.queueing_delays);
+        archive_history(ar, d.depth_area);
+        archive_history(ar, d.max_depth);
+        archive_history(ar, d.last_change);
+    }
+    archive_history(ar, io_horizon);
+    archive_history(ar, load_samples);
+}
+
+static const std::string CHECKPOINT_MAGIC = "SIMCKPT5";
+
+static uint64_t fnv1a(const std::string &bytes) {
+    uint64_t hash = 0xcbf29ce484222325ull;
+    for (unsigned char c : bytes) hash = (hash ^ c) * 0x100000001b3ull;
+    return hash;
+}
+
+
+//Checkpoint work to do at the top of this tick: the initial resume, a periodic save, or a what-if snapshot
+bool Simulator::checkpoint_due(unsigned int now) const {
+    return resume_pending || ((!options.checkpoint_path.empty() || options.what_if.active) && now > 0 &&
+                              now % options.checkpoint_interval == 0);
+}
+
+//The process table, the clock and the policy state. A what-if restore changes the process in the table
+//(it has not arrived yet at the snapshot).
+void Simulator::archive_run(state_archive &ar) {
+    archive(ar, list_process);
+    if (ar.loading() && what_if_state.replaying) {
+        for (auto &p : list_process) if (p.PID == options.what_if.PID) apply_what_if(options.what_if, p);
+    }
+    archive(ar, current_time);
+    archive(ar, terminated_count);
+    archive_state(ar);
+}
+
+//Write the run state and the OS state to options.checkpoint_path. The trace is not copied into every checkpoint:
+//the new part is appended to <checkpoint>.trace and only its length is stored. Both files are replaced atomically
+//enough that a run killed mid-write resumes from the previous checkpoint.
+void Simulator::save_checkpoint() {
+    const std::string &trace = execution_status;
+    std::ofstream trace_file(options.checkpoint_path + ".trace", trace_flushed == 0 ? std::ios::binary | std::ios::trunc
+                                                                                   : std::ios::binary | std::ios::app);
+    trace_file.write(trace.data() + trace_flushed, trace.size() - trace_flushed);
+    trace_file.close();
+    trace_flushed = trace.size();
+
+    state_archive ar(state_archive::SAVE);
+    std::string magic = CHECKPOINT_MAGIC;
+    std::string signature = options.run_signature;
+    archive(ar, magic);
+    archive(ar, signature);
+    archive(ar, trace_flushed);
+    archive_run(ar);
+    archive_os_state(ar);
+    uint64_t checksum = fnv1a(ar.data());
+
+    std::string temporary = options.checkpoint_path + ".tmp";
+    std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+    file.write(ar.data().data(), ar.data().size());
+    file.write(reinterpret_cast<const char*>(&checksum), sizeof(checksum));
+    file.close();
+    if (!file || std::rename(temporary.c_str(), options.checkpoint_path.c_str()) != 0) {
+        std::cerr << "Error: unable to write checkpoint " << options.checkpoint_path << std::endl;
+    }
+}
+
+//Restore options.resume_path into the run state and the OS state, and the trace up to the checkpoint.
+//Returns false with a message if the checkpoint is unreadable or belongs to a different run.
+bool Simulator::load_checkpoint() {
+    const std::string &resume_path = options.resume_path;
+    std::ifstream file(resume_path, std::ios::binary);
+    std::string bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    uint64_t checksum = 0;
+    if (!file.is_open() || bytes.size() < sizeof(checksum)) {
+        std::cerr << "Error: unable to read checkpoint " << resume_path << std::endl;
+        return false;
+    }
+    std::memcpy(&checksum, bytes.data() + bytes.size() - sizeof(checksum), sizeof(checksum));
+    bytes.resize(bytes.size() - sizeof(checksum));
+    if (fnv1a(bytes) != checksum) {
+        std::cerr << "Error: checkpoint " << resume_path << " is corrupt" << std::endl;
+        return false;
+    }
+
+    std::string trace;
+    try {
+        state_archive ar(state_archive::LOAD, bytes);
+        std::string magic, signature;
+        uint64_t trace_length;
+        archive(ar, magic);
+        archive(ar, signature);
+        if (magic != CHECKPOINT_MAGIC || signature != options.run_signature) {
+            std::cerr << "Error: checkpoint " << resume_path << " was written by a different run (" << signature << ")" << std::endl;
+            return false;
+        }
+        archive(ar, trace_length);
+        archive_run(ar);
+        archive_os_state(ar);
+        if (!ar.exhausted()) throw std::runtime_error("checkpoint has trailing data");
+
+        std::ifstream trace_file(resume_path + ".trace", std::ios::binary);
+        trace.assign(trace_length, '\0');
+        if (!trace_file.read(&trace[0], trace_length)) throw std::runtime_error("trace file is shorter than the checkpoint");
+    } catch (const std::exception &error) {
+        std::cerr << "Error: unable to resume from " << resume_path << ": " << error.what() << std::endl;
+        return false;
+    }
+    restore_trace(trace);
+
+    if (resume_path == options.checkpoint_path) {
+        // keep appending to the same trace file, dropping whatever was written after this checkpoint
+        std::filesystem::resize_file(resume_path + ".trace", trace.size());
+        trace_flushed = trace.size();
+    }
+    return true;
+}
+
+//Replace the trace with one restored from a checkpoint or snapshot; the sinks start over and get its rows
+void Simulator::restore_trace(const std::string &trace) {
+    execution_status = trace;
+    for (auto sink : sinks) sink->restart();
+    forward_trace(trace);
+}
+
+//Pass rows of an execution table to the sinks
+void Simulator::forward_trace(const std::string &rows) {
+    if (sinks.empty()) return;
+    std::istringstream lines(rows);
+    std::string line;
+    while (std::getline(lines, line)) {
+        unsigned int time;
+        int PID;
+        states old_state, new_state;
+        if (!parse_exec_status(line, time, PID, old_state, new_state)) continue;
+        for (auto sink : sinks) sink->transition(time, PID, old_state, new_state);
+    }
+}
+
+//-------------------------------------------WHAT-IF RE-SIMULATION------------------------------------------
+
+os_counters Simulator::capture_counters(unsigned int now) {
+    os_counters counters = {paging.references, paging.tlb_hits, paging.page_faults, paging.evictions, {}};
+    for (auto &d : io_devices) {
+        uint64_t area = d.depth_area + (uint64_t)d.queue.size() * (now - std::min(d.last_change, now));
+        counters.devices.push_back({d.busy_time, d.queueing_delay, d.queueing_delays, area, d.window_max_depth});
+        d.window_max_depth = d.queue.size();
+    }
+    return counters;
+}
+
+void apply_what_if(const what_if_change &change, PCB &process) {
+    for (auto &field : change.fields) {
+        if (field.first == "size") process.size = field.second;
+        else if (field.first == "arrival") process.arrival_time = field.second;
+        else if (field.first == "burst") process.processing_time = process.remaining_time = field.second;
+        else if (field.first == "io-freq") process.io_freq = field.second;
+        else if (field.first == "io-duration") process.io_duration = field.second;
+        else if (field.first == "nice") process.nice = field.second;
+        else if (field.first == "deadline") process.deadline = field.second;
+        else if (field.first == "tickets") process.tickets = field.second;
+        else if (field.first == "device") process.device = field.second;
+    }
+}
+
+//Arrival order of the index-based schedulers. Only the part not reached yet goes into a digest, and a what-if
+//restore re-sorts it since the changed process may have moved.
+void Simulator::archive_arrivals(state_archive &ar, std::vector<size_t> &arrivals, size_t &next_arrival) {
+    archive(ar, next_arrival);
+    if (ar.digest()) {
+        std::vector<size_t> upcoming(arrivals.begin() + next_arrival, arrivals.end());
+        archive(ar, upcoming);
+        return;
+    }
+    archive(ar, arrivals);
+    if (ar.loading() && what_if_state.replaying) {
+        std::sort(arrivals.begin() + next_arrival, arrivals.end(), [&](size_t a, size_t b){
+            return std::make_pair(list_process[a].arrival_time, a) < std::make_pair(list_process[b].arrival_time, b);
+        });
+    }
+}
+
+void Simulator::add_arrival(std::vector<size_t> &arrivals, size_t next_arrival, size_t index) const {
+    auto position = std::upper_bound(arrivals.begin() + next_arrival, arrivals.end(), index, [&](size_t a, size_t b){
+        return list_process[a].arrival_time < list_process[b].arrival_time;
+    });
+    arrivals.insert(position, index);
+}
+
+void Simulator::order_arrivals(std::vector<size_t> &arrivals, size_t &next_arrival) const {
+    arrivals.resize(total_processes);
+    for (size_t i = 0; i < total_processes; i++) arrivals[i] = i;
+    std::stable_sort(arrivals.begin(), arrivals.end(), [&](size_t a, size_t b){
+        return list_process[a].arrival_time < list_process[b].arrival_time;
+    });
+    next_arrival = 0;
+}
+
+void Simulator::admit_arrivals(const std::vector<size_t> &arrivals, size_t &next_arrival, std::set<size_t> &pending) {
+    while (next_arrival < total_processes && list_process[arrivals[next_arrival]].arrival_time == current_time) {
+        size_t i = arrivals[next_arrival++];
+        if (!admit(i)) pending.insert(i);
+    }
+}
+
+void Simulator::retry_pending(std::set<size_t> &pending, bool &memory_freed) {
+    if (!memory_freed) return;
+    unsigned int largest = largest_free_partition();
+    for (auto it = pending.begin(); it != pending.end() && largest > 0;) {
+        if (list_process[*it].size <= largest && admit(*it)) {
+            it = pending.erase(it);
+            largest = largest_free_partition();
+        } else ++it;
+    }
+    memory_freed = false;
+}
+
+void Simulator::keep_metrics() {
+    metrics_kept = true;
+    metrics.clear();
+    for (auto &p : list_process) metrics.push_back(init_metrics(p));
+}
+
+void Simulator::transition(unsigned int time, size_t index, states old_state, states new_state) {
+    emit(time, list_process[index].PID, old_state, new_state);
+    if (metrics_kept) track_transition(metrics[index], time, new_state);
+    list_process[index].state = new_state;
+}
+
+void Simulator::what_if_record(unsigned int now) {
+    what_if_snapshot snapshot;
+    snapshot.time = now;
+    snapshot.trace_length = execution_status.size();
+    snapshot.log_length = memory_log.size();
+
+    std::vector<memory_sample> log;
+    log.swap(memory_log);   // the log so far is a prefix of the final one, no need to copy it
+    state_archive saved(state_archive::SAVE);
+    archive_run(saved);
+    archive_os_state(saved);
+    log.swap(memory_log);
+    snapshot.state = saved.data();
+
+    state_archive digest(state_archive::DIGEST);
+    archive_run(digest);
+    archive_os_state(digest);
+    snapshot.digest = digest.data();
+
+    snapshot.counters = capture_counters(now);
+    what_if_state.snapshots.push_back(std::move(snapshot));
+}
+
+void Simulator::what_if_restore() {
+    const what_if_snapshot *from = nullptr;
+    for (auto &snapshot : what_if_state.snapshots) {
+        if (snapshot.time <= what_if_state.affected_time) from = &snapshot;
+    }
+    if (from == nullptr) return;    // the change matters from the start
+
+    state_archive ar(state_archive::LOAD, from->state);
+    archive_run(ar);
+    archive_os_state(ar);
+    memory_log.assign(what_if_state.log.begin(), what_if_state.log.begin() + from->log_length);
+    restore_trace(what_if_state.trace.substr(0, from->trace_length));
+    what_if_state.restored_from = from->time;
+}
+
+//At a snapshot time of the original run: if the state is the same again, the rest of the run is the original one.
+//Its trace and memory log are spliced in and its statistics added; returns true to stop the simulation.
+bool Simulator::what_if_converged(unsigned int now) {
+    auto &snapshots = what_if_state.snapshots;
+    auto at = std::lower_bound(snapshots.begin(), snapshots.end(), now, [](const what_if_snapshot &snapshot, unsigned int time){
+        return snapshot.time < time;
+    });
+    if (at == snapshots.end() || at->time != now) return false;
+
+    state_archive digest(state_archive::DIGEST);
+    archive_run(digest);
+    archive_os_state(digest);
+    if (digest.data() != at->digest) return false;
+
+    const std::string &original = what_if_state.trace;
+    size_t suffix = original.size() - print_exec_footer().size() - at->trace_length;
+    std::string rest = original.substr(at->trace_length, suffix);
+    execution_status += rest;
+    forward_trace(rest);
+    memory_log.insert(memory_log.end(), what_if_state.log.begin() + at->log_length, what_if_state.log.end());
+
+    os_counters current = capture_counters(now);
+    const os_counters &from = at->counters, &to = what_if_state.counters;
+    paging.references = current.references + (to.references - from.references);
+    paging.tlb_hits = current.tlb_hits + (to.tlb_hits - from.tlb_hits);
+    paging.page_faults = current.page_faults + (to.page_faults - from.page_faults);
+    paging.evictions = current.evictions + (to.evictions - from.evictions);
+    for (size_t i = 0; i < io_devices.size(); i++) {
+        io_device &d = io_devices[i];
+        const io_device &last = what_if_state.devices[i];
+        d.requests = last.requests;
+        d.busy_time = current.devices[i].busy_time + (to.devices[i].busy_time - from.devices[i].busy_time);
+        d.queueing_delay = current.devices[i].queueing_delay + (to.devices[i].queueing_delay - from.devices[i].queueing_delay);
+        d.queueing_delays = current.devices[i].queueing_delays;
+        d.queueing_delays.merge(to.devices[i].queueing_delays);
+        d.queueing_delays.subtract(from.devices[i].queueing_delays);
+        d.depth_area = current.devices[i].depth_area + (last.depth_area - from.devices[i].depth_area);
+        d.last_change = last.last_change;
+        d.queue = last.queue;
+        unsigned int later_max = last.window_max_depth;
+        for (auto later = at + 1; later != snapshots.end(); ++later) {
+            later_max = std::max(later_max, later->counters.devices[i].window_max_depth);
+        }
+        d.max_depth = std::max(d.max_depth, later_max);
+    }
+    io_horizon = what_if_state.horizon;
+    what_if_state.converged_at = now;
+    return true;
+}
+
+//Called at the top of a tick when checkpoint_due(). The archive holds the whole run state, including the clock,
+//so a resume continues with exactly the same next tick. Returns true when the run must stop: a what-if run has
+//re-converged, or the checkpoint to resume from could not be read.
+bool Simulator::checkpoint_tick(unsigned int now) {
+    if (resume_pending) {
+        resume_pending = false;
+        if (what_if_state.replaying) what_if_restore();
+        else if (!load_checkpoint()) error = true;
+        return error;
+    }
+    if (what_if_state.recording) {
+        what_if_record(now);
+        return false;
+    }
+    if (what_if_state.replaying) return what_if_converged(now);
+    save_checkpoint();
+    return false;
+}
+
+std::string Simulator::what_if_summary() const {
+    if (!options.what_if.active) return "";
+    std::ostringstream summary;
+    summary << "What-if: re-simulated from " << what_if_state.restored_from << " ms";
+    if (what_if_state.converged_at > 0) summary << ", re-converged with the original run at " << what_if_state.converged_at << " ms";
+    else summary << ", did not re-converge";
+    return summary.str();
+}
+
+//---------------------------------------------WATCHDOG------------------------------------------------
+
+//Largest request the current memory model can ever satisfy, with all of memory free
+unsigned int Simulator::memory_capacity() const {
+    if (options.memory_model == FIXED_PARTITIONS) {
+        unsigned int largest = 0;
+        for (auto &partition : memory_paritions) largest = std::max(largest, partition.size);
+        return largest;
+    }
+    if (options.memory_model == BUDDY) return 1u << (dynamic_partitions.buddy_free.size() - 1);
+    if (options.memory_model == PAGED) return UINT32_MAX;
+    return options.memory_size;
+}
+
+bool Simulator::admission_feasible(const std::vector<PCB> &list_process) const {
+    bool feasible = true;
+    for (const auto &p : list_process) {
+        if (p.size > memory_capacity()) {
+            std::cerr << "Error: process " << p.PID << " needs " << p.size << " MB but the largest possible partition is "
+                      << memory_capacity() << " MB, it can never be admitted" << std::endl;
+            feasible = false;
+        }
+        if (!io_devices.empty() && p.io_freq > 0 && (p.device < 0 || (size_t)p.device >= io_devices.size())) {
+            std::cerr << "Error: process " << p.PID << " does its I/O on device " << p.device << " but only "
+                      << io_devices.size() << " device(s) are configured" << std::endl;
+            feasible = false;
+        }
+        if (!process_schedulable(p)) feasible = false;
+    }
+    return feasible;
+}
+
+bool Simulator::admission_possible(unsigned int now) const {
+    unsigned int largest = largest_free_partition();
+    for (const auto &p : list_process) {
+        if (p.state == NOT_ASSIGNED && p.arrival_time <= now && p.size <= largest) return true;
+    }
+    return false;
+}
+
+bool Simulator::watchdog_expired(unsigned int now, bool stalled, size_t unfinished) {
+    std::string reason;
+    if (stalled) {
+        reason = "no process can make progress";
+    } else if (options.time_limit > 0 && now >= options.time_limit) {
+        reason = "simulated time limit of " + std::to_string(options.time_limit) + " ms reached";
+    } else if (options.wall_limit > 0 && (now & 1023) == 0 &&
+               std::chrono::duration<double>(std::chrono::steady_clock::now() - wall_start).count() >= options.wall_limit) {
+        std::ostringstream limit;
+        limit << "wall-time limit of " << options.wall_limit << " s reached";
+        reason = limit.str();
+    } else {
+        return false;
+    }
+    std::cerr << "Watchdog: stopped at " << now << " ms, " << reason << "; "
+              << unfinished << " process(es) not terminated" << std::endl;
+    watchdog_tripped = true;
+    return true;
+}
+
+//---------------------------------------------THE SIMULATOR-------------------------------------------
+
+Simulator::Simulator(const simulator_options &options) : options(options) {
+    init_memory();
+    init_devices();
+}
+
+void Simulator::load(const std::vector<PCB> &processes) {
+    workload = processes;
+    list_process = processes;
+    for (auto &p : list_process) p.state = NOT_ASSIGNED;
+    total_processes = list_process.size();
+    terminated_count = 0;
+    current_time = 0;
+    execution_status.clear();     // keeps its capacity for the next run of a reused simulator
+    if (trace_kept) execution_status += print_exec_header();
+
+    init_memory();
+    init_devices();
+    done = false;
+    error = false;
+    watchdog_tripped = false;
+    resume_pending = !options.resume_path.empty();
+    trace_flushed = 0;
+    wall_start = std::chrono::steady_clock::now();
+    load_samples.reset(options.sample_interval, options.sample_rows, workload);
+    trace_store.reset();
+    if (!options.trace_index_path.empty()) {
+        trace_store = std::make_unique<trace_store_writer>(options.trace_index_path, options.index_interval, workload);
+        if (!trace_store->ok()) error = done = true;
+    }
+
+    for (auto sink : sinks) sink->restart();
+    start();
+}
+
+bool Simulator::step() {
+    if (done) return false;
+    bool over = !arrivals_open && terminated_count >= total_processes;
+    if (!over && checkpoint_due(current_time)) over = checkpoint_tick(current_time);
+    // stalled() is only meaningful once a resume has restored the state
+    if (!over) over = watchdog_expired(current_time, !arrivals_open && stalled(), total_processes - terminated_count);
+    if (over) {
+        if (trace_store && !trace_store->finish()) error = true;
+        trace_store.reset();
+        if (!error && trace_kept) execution_status += print_exec_footer();
+        done = true;
+        for (auto sink : sinks) sink->finish();
+        return false;
+    }
+
+    tick();
+    if (load_samples.enabled() && load_samples.due(current_time)) sample_load(current_time);
+    current_time++;
+    return true;
+}
+
+//The load at the end of tick now
+void Simulator::sample_load(unsigned int now) {
+    unsigned int partitions = 0;
+    if (options.memory_model == PAGED) partitions = paging.frame_owner.size() - paging.free_frames.size();
+    else if (options.memory_model != FIXED_PARTITIONS) partitions = dynamic_partitions.blocks.size();
+    else for (auto &partition : memory_paritions) partitions += partition.occupied != -1;
+    load_samples.sample(now, partitions, memory_allocated);
+}
+
+void Simulator::run_until(unsigned int time) {
+    while (current_time < time && step()) {}
+}
+
+void Simulator::run() {
+    if (!options.what_if.active) {
+        while (step()) {}
+        return;
+    }
+
+    std::vector<PCB> original = workload, changed = workload;
+    auto process = std::find_if(changed.begin(), changed.end(), [&](const PCB &p){ return p.PID == options.what_if.PID; });
+    if (process == changed.end()) {
+        std::cerr << "Error: what-if process " << options.what_if.PID << " is not in the workload" << std::endl;
+        error = done = true;
+        return;
+    }
+    // the changed process must pass the same check as the workload it replaces
+    PCB checked = *process;
+    apply_what_if(options.what_if, checked);
+    if (!admission_feasible({checked})) {
+        error = done = true;
+        return;
+    }
+
+    what_if_state = what_if_run();
+    load(original);
+    what_if_state.recording = true;
+    while (step()) {}
+    what_if_state.recording = false;
+    what_if_state.trace = execution_status;
+    what_if_state.log = memory_log;
+    what_if_state.counters = capture_counters(io_horizon);
+    what_if_state.devices = io_devices;
+    for (size_t i = 0; i < io_devices.size(); i++) what_if_state.devices[i].window_max_depth = what_if_state.counters.devices[i].window_max_depth;
+    what_if_state.horizon = io_horizon;
+
+    unsigned int original_arrival = process->arrival_time;
+    apply_what_if(options.what_if, *process);
+    what_if_state.affected_time = std::min(original_arrival, process->arrival_time);
+
+    what_if_state.replaying = true;
+    load(changed);
+    resume_pending = true;
+    while (step()) {}
+    what_if_state.replaying = false;
+}
+
+void Simulator::deliver(const PCB &process) {
+    workload.push_back(process);
+    list_process.push_back(process);
+    list_process.back().state = NOT_ASSIGNED;
+    total_processes++;
+    if (load_samples.enabled()) load_samples.arrival(process.arrival_time);
+    if (trace_store) trace_store->add_process(process);
+    if (metrics_kept) metrics.push_back(init_metrics(process));
+    process_added(list_process.size() - 1);
+}
+
+void Simulator::start_stream() {
+    hold_arrivals(true);
+    load({});
+    streaming = true;
+}
+
+bool Simulator::stream(const PCB &process) {
+    if (!streaming || process.arrival_time < current_time) return streaming = false;
+    deliver(process);
+    // a time limit is left to the final run, when the watchdog can count every process
+    run_until(options.time_limit > 0 ? std::min(process.arrival_time, options.time_limit) : process.arrival_time);
+    return true;
+}
+
+void Simulator::finish_stream(const std::vector<PCB> &workload) {
+    hold_arrivals(false);
+    if (!streaming) load(workload);
+    streaming = false;
+    run();
+}
+
+void Simulator::attach_trace(trace_sink &sink) {
+    sinks.push_back(&sink);
+}
+
+void Simulator::detach_trace(trace_sink &sink) {
+    sinks.erase(std::remove(sinks.begin(), sinks.end(), &sink), sinks.end());
+}
+
+void Simulator::emit(unsigned int time, int PID, states old_state, states new_state) {
+    if (load_samples.enabled()) load_samples.transition(old_state, new_state);
+    if (trace_store) trace_store->transition(time, PID, new_state);
+    if (trace_kept) execution_status += print_exec_status(time, PID, old_state, new_state);
+    if (what_if_state.recording) return;   // only the run that is kept is traced
+    for (auto sink : sinks) sink->transition(time, PID, old_state, new_state);
+}
+
+std::vector<process_metrics> Simulator::run_metrics() const {
+    if (metrics_kept && !options.what_if.active) return metrics;
+    return metrics_from_trace(execution_status, workload);
+}
+
+latency_report Simulator::latency() const {
+    latency_report report = latency_from_metrics(run_metrics());
+    for (auto &d : io_devices) report.io_queueing.merge(d.queueing_delays);
+    return report;
+}
+
+//-------------------------------------------------I/O-------------------------------------------------
+
+bool read_workload(const std::string &file_name, std::vector<PCB> &processes) {
+    std::ifstream input_file(file_name);
+
+    if (!input_file.is_open()) {
+        std::cerr << "Error: Unable to open file: " << file_name << std::endl;
+        return false;
+    }
+
+    read_workload(input_file, processes);
+    input_file.close();
+    return true;
+}
+
+void read_workload(std::istream &input, std::vector<PCB> &processes) {
+    std::string line;
+    while(std::getline(input, line)) {
+        if (line.size() == 0) continue;
+        auto input_tokens = split_delim(line, ", ");
+        auto new_process = add_process(input_tokens);
+        new_process.state = NOT_ASSIGNED;
+        processes.push_back(new_process);
+    }
+}
+
+//-------------------------------------------RESULT CACHE----------------------------------------------
+
+std::string Simulator::result_key(const std::vector<PCB> &processes) const {
+    if (!options.checkpoint_path.empty() || !options.resume_path.empty() || !options.trace_index_path.empty()) return "";
+
+    std::ostringstream key;
+    key << "engine " << ENGINE_VERSION << "\npolicy " << policy_signature() << "\nmemory " << options.memory_model;
+    if (options.memory_model == FIXED_PARTITIONS) {
+        for (auto &partition : DEFAULT_PARTITIONS) key << " " << partition.size;
+    }
+    key << " " << options.memory_size << " " << options.frame_count << " " << options.tlb_size << " "
+        << options.page_fault_time << " " << options.replacement_policy
+        << "\nswap " << options.swapping_enabled << " " << options.swap_out_time << " " << options.swap_in_time << "\ndevices";
+    for (auto &device : options.devices) key << " " << device.name << ":" << device.slots << ":" << device.elevator;
+    key << "\nwhat-if " << options.what_if.active << " " << options.what_if.PID;
+    for (auto &field : options.what_if.fields) key << " " << field.first << "=" << field.second;
+    key << "\ntime-limit " << options.time_limit << "\nsamples " << options.sample_interval << " " << options.sample_rows << "\nworkload\n";
+    for (auto &p : processes) {
+        key << p.PID << ", " << p.size << ", " << p.arrival_time << ", " << p.processing_time << ", " << p.io_freq << ", "
+            << p.io_duration << ", " << p.nice << ", " << p.deadline << ", " << p.tickets << ", " << p.device << "\n";
+    }
+    return key.str();
+}
+
+std::filesystem::path result_cache::entry_path(const std::string &key) const {
+    std::ostringstream name;
+    name << std::hex << std::setw(16) << std::setfill('0') << fnv1a(key) << ".run";
+    return directory / name.str();
+}
+
+//An entry is the key and then every output, each as "<bytes>\n<bytes of text>"
+static void write_field(std::ostream &out, const std::string &text) {
+    out << text.size() << '\n' << text;
+}
+
+static bool read_field(std::istream &in, std::string &text) {
+    size_t size;
+    if (!(in >> size) || in.get() != '\n') return false;
+    text.resize(size);
+    return (bool)in.read(&text[0], size);
+}
+
+bool result_cache::lookup(const std::string &key, cached_result &result) const {
+    auto path = entry_path(key);
+    std::ifstream entry(path, std::ios::binary);
+    std::string stored_key;
+    if (!read_field(entry, stored_key) || stored_key != key) return false;
+    if (!read_field(entry, result.execution) || !read_field(entry, result.metrics) || !read_field(entry, result.memory) ||
+        !read_field(entry, result.devices) || !read_field(entry, result.what_if) || !read_field(entry, result.latency) ||
+        !read_field(entry, result.samples)) return false;
+
+    std::error_code ignored;    // evicted meanwhile by someone else: it was still a hit
+    std::filesystem::last_write_time(path, std::filesystem::file_time_type::clock::now(), ignored);
+    return true;
+}
+
+void result_cache::store(const std::string &key, const cached_result &result) const {
+    std::error_code error;
+    std::filesystem::create_directories(directory, error);
+    auto path = entry_path(key);
+    auto temporary = path;
+    temporary += ".tmp" + std::to_string(std::random_device()());
+
+    std::ofstream entry(temporary, std::ios::binary);
+    write_field(entry, key);
+    write_field(entry, result.execution);
+    write_field(entry, result.metrics);
+    write_field(entry, result.memory);
+    write_field(entry, result.devices);
+    write_field(entry, result.what_if);
+    write_field(entry, result.latency);
+    write_field(entry, result.samples);
+    entry.close();
+    // a cache that cannot be written only costs the next run its hit
+    if (entry.fail()) std::filesystem::remove(temporary, error);
+    else std::filesystem::rename(temporary, path, error);
+    evict();
+}
+
+void result_cache::evict() const {
+    struct cache_entry {
+        std::filesystem::file_time_type    used;
+        uint64_t                            size;
+        std::filesystem::path               path;
+    };
+    std::vector<cache_entry> entries;
+    uint64_t total = 0;
+    std::error_code error;
+    for (auto &file : std::filesystem::directory_iterator(directory, error)) {
+        if (file.path().extension() != ".run") continue;
+        auto used = file.last_write_time(error);
+        if (error) continue;    // evicted by another run while we looked
+        auto size = file.file_size(error);
+        if (error) continue;
+        entries.push_back({used, size, file.path()});
+        total += size;
+    }
+    if (total <= capacity) return;
+
+    std::sort(entries.begin(), entries.end(), [](const cache_entry &a, const cache_entry &b){ return a.used < b.used; });
+    for (auto &entry : entries) {
+        if (total <= capacity) break;
+        std::filesystem::remove(entry.path, error);
+        total -= entry.size;
+    }
+}
+
+int run_cached(Simulator &simulator, const std::vector<PCB> &workload, cached_result &result) {
+    const simulator_options &options = simulator.configuration();
+    result_cache cache(options.cache_path, options.cache_size);
+    std::string key = options.cache_path.empty() ? "" : simulator.result_key(workload);
+    if (!key.empty() && cache.lookup(key, result)) return 0;
+
+    simulator.load(workload);
+    simulator.run();
+    if (simulator.failed()) return -1;
+    result.execution = simulator.execution();
+    result.metrics = simulator.print_process_metrics();
+    result.memory = simulator.print_memory_log();
+    result.devices = simulator.has_devices() ? simulator.print_device_stats() : "";
+    result.what_if = simulator.what_if_summary();
+    std::ostringstream latency;
+    simulator.latency().write(latency);
+    result.latency = latency.str();
+    result.samples = simulator.has_samples() ? simulator.print_load_samples() : "";
+    if (simulator.stopped_by_watchdog()) return 1;
+
+    if (!key.empty()) cache.store(key, result);
+    return 0;
+}
+
+//---------------------------------------------PIPELINE------------------------------------------------
+
+const size_t PIPELINE_RING_SIZE = 1 << 14;
+
+//Event of the simulate -> format ring that is not a transition: the simulator started over (see restart())
+const int RESTART_EVENT = -1;
+
+//Simulator end of the simulate -> format ring. The caller closes the ring: a run the watchdog stopped while the
+//input was streaming in may still start over.
+class event_pipe : public trace_sink {
+public:
+    explicit event_pipe(spsc_ring<exec_event> &events) : events(events) {}
+    void transition(unsigned int time, int PID, states old_state, states new_state) override {
+        events.push({time, PID, (uint8_t)old_state, (uint8_t)new_state});
+    }
+    void restart() override {
+        events.push({0, RESTART_EVENT, 0, 0});
+    }
+
+private:
+    spsc_ring<exec_event> &events;
+};
+
+//The processes handed to the simulator so far, in input order. The format stage picks them up when the first
+//event of one it does not know yet comes through; the simulating thread only appends.
+struct delivered_processes {
+    std::mutex          lock;
+    std::vector<PCB>    processes;
+
+    void add(const PCB &process) {
+        std::lock_guard<std::mutex> guard(lock);
+        processes.push_back(process);
+    }
+
+    //Metrics for the processes delivered since the last call, in order
+    void catch_up(std::vector<process_metrics> &metrics, std::unordered_map<int, size_t> &index_of) {
+        std::lock_guard<std::mutex> guard(lock);
+        for (size_t i = metrics.size(); i < processes.size(); i++) {
+            index_of[processes[i].PID] = i;
+            metrics.push_back(init_metrics(processes[i]));
+        }
+    }
+};
+
+//Parse stage: one PCB per input line
+static void parse_stage(std::ifstream &input_file, spsc_ring<PCB> &processes) {
+    std::string line;
+    while(std::getline(input_file, line)) {
+        if (line.size() == 0) continue;
+        auto new_process = add_process(split_delim(line, ", "));
+        new_process.state = NOT_ASSIGNED;
+        processes.push(new_process);
+    }
+    processes.close();
+}
+
+//Format stage: renders the execution table into file_name as the events come, and the metrics along with it
+//(the same ones metrics_from_trace would rebuild from the table). Processes that never had an event are left
+//for the caller to add once the run is over.
+static void format_stage(spsc_ring<exec_event> &events, const char *file_name, delivered_processes &delivered,
+                         std::vector<process_metrics> &metrics, bool &written) {
+    std::unordered_map<int, size_t> index_of;
+    std::ofstream output_file;
+    std::string table;
+    exec_event event;
+    while (events.pop(event)) {
+        if (event.PID == RESTART_EVENT) {
+            output_file.close();
+            output_file.open(file_name, std::ios::trunc);
+            table = print_exec_header();
+            metrics.clear();
+            index_of.clear();
+            continue;
+        }
+        table += print_exec_status(event.time, event.PID, (states)event.old_state, (states)event.new_state);
+        auto i = index_of.find(event.PID);
+        if (i == index_of.end()) {
+            delivered.catch_up(metrics, index_of);
+            i = index_of.find(event.PID);
+        }
+        if (i != index_of.end()) track_transition(metrics[i->second], event.time, (states)event.new_state);
+        if (table.size() >= (1 << 16)) {
+            output_file << table;
+            table.clear();
+        }
+    }
+    output_file << table << print_exec_footer();
+    output_file.close();
+    written = !output_file.fail();
+}
+
+//simulate_input_file for a run that does not need its trace in memory: the calling thread simulates while one
+//thread parses the input and another formats the trace. Parsed processes are delivered to the running simulator
+//as they come, and it simulates up to the arrival of the latest one, so the simulation starts with the first line
+//instead of after the last. An input that is not in arrival order cannot be streamed (a process would arrive in
+//the simulated past): from the first such process on, the rest is read and the run starts over with all of it.
+static int simulate_pipelined(Simulator &simulator, const std::string &file_name) {
+    std::ifstream input_file(file_name);
+    if (!input_file.is_open()) {
+        std::cerr << "Error: Unable to open file: " << file_name << std::endl;
+        return -1;
+    }
+
+    spsc_ring<PCB> parsed(PIPELINE_RING_SIZE);
+    std::thread parser(parse_stage, std::ref(input_file), std::ref(parsed));
+    spsc_ring<exec_event> events(PIPELINE_RING_SIZE);
+    event_pipe pipe(events);
+    delivered_processes delivered;
+    std::vector<process_metrics> metrics;
+    bool written = false;
+    std::thread formatter(format_stage, std::ref(events), "execution.txt", std::ref(delivered), std::ref(metrics), std::ref(written));
+
+    simulator.keep_trace(false);
+    simulator.attach_trace(pipe);
+    simulator.start_stream();
+    bool feasible = true;
+    for (PCB process; parsed.pop(process);) {
+        // every process is checked, so every error is reported
+        if (!simulator.admission_feasible({process})) feasible = false;
+        delivered.add(process);
+        if (feasible) simulator.stream(process);
+    }
+    parser.join();
+    if (feasible) simulator.finish_stream(delivered.processes);
+    else simulator.hold_arrivals(false);
+    events.close();
+    simulator.detach_trace(pipe);
+    simulator.keep_trace(true);
+    formatter.join();
+    if (!feasible) {
+        std::filesystem::remove("execution.txt");
+        if (!simulator.configuration().trace_index_path.empty()) std::filesystem::remove(simulator.configuration().trace_index_path);
+        return -1;
+    }
+
+    // the processes that never had an event, in input order among the rest
+    std::unordered_map<int, size_t> index_of;
+    for (size_t i = 0; i < metrics.size(); i++) index_of[metrics[i].PID] = i;
+    delivered.catch_up(metrics, index_of);
+
+    report_output(written, "execution.txt");
+    write_output(print_metrics(metrics), "metrics.txt");
+    write_output(simulator.print_memory_log(), "memory.txt");
+    if (simulator.has_devices()) write_output(simulator.print_device_stats(), "devices.txt");
+    if (simulator.has_samples()) write_output(simulator.print_load_samples(), "samples.txt");
+
+    return simulator.stopped_by_watchdog() ? 1 : 0;
+}
+
+int simulate_input_file(Simulator &simulator, const std::string &file_name) {
+    if (!simulator.needs_trace()) return simulate_pipelined(simulator, file_name);
+
+    std::vector<PCB> list_process;
+    if (!read_workload(file_name, list_process)) return -1;
+    if (!simulator.admission_feasible(list_process)) return -1;
+
+    cached_result result;
+    int status = run_cached(simulator, list_process, result);
+    if (status < 0) return -1;
+
+    if (!result.what_if.empty()) std::cout << result.what_if << std::endl;
+    write_output(result.execution, "execution.txt");
+    write_output(result.metrics, "metrics.txt");
+    write_output(result.memory, "memory.txt");
+    if (simulator.has_devices()) write_output(result.devices, "devices.txt");
+    if (simulator.has_samples()) write_output(result.samples, "samples.txt");
+
+    return status;
+}
+
+std::unique_ptr<Simulator> make_simulator(const std::string &policy, const std::vector<std::string> &args, const simulator_options &options) {
+    if (policy == "RR") return make_rr_simulator(args, options);
+    if (policy == "EP") return make_ep_simulator(args, options);
+    if (policy == "EP_RR") return make_ep_rr_simulator(args, options);
+    if (policy == "MLFQ") return make_mlfq_simulator(args, options);
+    if (policy == "CFS") return make_cfs_simulator(args, options);
+    if (policy == "EDF") return make_edf_simulator(args, options);
+
+    // the two modes of the SRTF and STRIDE binaries have their own names
+    std::vector<std::string> mode_args = args;
+    if (policy == "SRTF" || policy == "SJF") {
+        mode_args.insert(mode_args.begin(), policy == "SJF" ? "sjf" : "srtf");
+        return make_srtf_simulator(mode_args, options);
+    }
+    if (policy == "STRIDE" || policy == "LOTTERY") {
+        mode_args.insert(mode_args.begin(), policy == "LOTTERY" ? "lottery" : "stride");
+        return make_stride_simulator(mode_args, options);
+    }
+    std::cerr << "Error: unknown policy " << policy << ", expected RR, EP, EP_RR, MLFQ, SRTF, SJF, CFS, EDF, STRIDE or LOTTERY" << std::endl;
+    return nullptr;
+}
+
+//-------------------------------------------TRACE STORE-----------------------------------------------
+
+trace_store_writer::trace_store_writer(const std::string &path, unsigned int interval, const std::vector<PCB> &workload)
+    : path(path), file(path, std::ios::binary), interval(std::max(interval, 1u)) {
+    if (!file) {
+        std::cerr << "Error: unable to create trace store " << path << std::endl;
+        return;
+    }
+    file << TRACE_STORE_MAGIC;
+    flushed = TRACE_STORE_MAGIC.size();
+    for (auto &p : workload) add_process(p);
+}
+
+void trace_store_writer::add_process(const PCB &process) {
+    index_of[process.PID] = processes.size();
+    processes.push_back({process.PID, process.size, process.arrival_time, process.processing_time, NEVER, NEVER});
+    table.push_back({(uint32_t)table.size(), NOT_ASSIGNED, -1, -1, 0, 0});
+    live_position.push_back(-1);
+}
+
+//Snapshot of the table as it stands before the first event at or after the next snapshot time; a stretch with
+//no events gets no snapshots, the query replays from the one before
+void trace_store_writer::snapshot_before(unsigned int time) {
+    if (time < next_snapshot) return;
+    unsigned int snapshot_time = time - time % interval;
+    snapshots.push_back({snapshot_time, flushed + buffer.data().size()});
+    char kind = 'S';
+    uint32_t count = live.size();
+    archive(buffer, kind);
+    archive(buffer, snapshot_time);
+    archive(buffer, count);
+    for (auto index : live) archive(buffer, table[index]);
+    next_snapshot = snapshot_time + interval;
+}
+
+void trace_store_writer::record(char kind, unsigned int time, uint32_t index, int32_t value) {
+    archive(buffer, kind);
+    archive(buffer, time);
+    archive(buffer, index);
+    archive(buffer, value);
+    if (buffer.data().size() >= (1 << 20)) flush();
+}
+
+void trace_store_writer::flush() {
+    file << buffer.data();
+    flushed += buffer.data().size();
+    buffer = state_archive(state_archive::SAVE);
+}
+
+void trace_store_writer::transition(unsigned int time, int PID, states new_state) {
+    auto found = index_of.find(PID);
+    if (found == index_of.end() || !file) return;
+    uint32_t index = found->second;
+    snapshot_before(time);
+    record('E', time, index, new_state);
+    end = std::max(end, time);
+
+    stored_process &p = table[index];
+    stored_workload_entry &entry = processes[index];
+    if (live_position[index] == -1 && new_state != TERMINATED) {
+        entry.admitted = std::min(entry.admitted, (uint32_t)time);
+        live_position[index] = live.size();
+        live.push_back(index);
+    }
+    if (p.state == RUNNING) p.cpu_used += time - p.since;
+    if (new_state == RUNNING && p.start_time == -1) p.start_time = time;
+    p.state = new_state;
+    p.since = time;
+    if (new_state == TERMINATED && live_position[index] != -1) {
+        entry.finished = time;
+        uint32_t moved = live.back();
+        live[live_position[index]] = moved;
+        live_position[moved] = live_position[index];
+        live.pop_back();
+        live_position[index] = -1;
+    }
+}
+
+void trace_store_writer::partition(unsigned int time, int PID, int partition_number) {
+    auto found = index_of.find(PID);
+    if (found == index_of.end() || !file) return;
+    snapshot_before(time);
+    record('M', time, found->second, partition_number);
+    table[found->second].partition = partition_number;
+}
+
+bool trace_store_writer::finish() {
+    if (!file) return false;
+    uint64_t footer = flushed + buffer.data().size();
+    uint64_t count = processes.size();
+    archive(buffer, interval);
+    archive(buffer, end);
+    archive(buffer, count);
+    for (auto &entry : processes) archive(buffer, entry);
+    archive(buffer, snapshots);
+    archive(buffer, footer);
+    flush();
+    file << TRACE_STORE_MAGIC;
+    file.close();
+    if (file.fail()) {
+        std::cerr << "Error: unable to write trace store " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool trace_store_reader::open(const std::string &store_path) {
+    path = store_path;
+    std::ifstream file(path, std::ios::binary);
+    std::string tail(sizeof(uint64_t) + TRACE_STORE_MAGIC.size(), '\0');
+    file.seekg(0, std::ios::end);
+    std::streamoff size = file.tellg();
+    if (!file || size < (std::streamoff)(2 * TRACE_STORE_MAGIC.size() + sizeof(uint64_t)) ||
+        !file.seekg(size - tail.size()).read(&tail[0], tail.size()) || tail.substr(sizeof(uint64_t)) != TRACE_STORE_MAGIC) {
+        std::cerr << "Error: " << path << " is not a complete trace store" << std::endl;
+        return false;
+    }
+    std::memcpy(&footer, tail.data(), sizeof(uint64_t));
+
+    try {
+        std::string bytes(size - tail.size() - footer, '\0');
+        file.seekg(footer).read(&bytes[0], bytes.size());
+        state_archive ar(state_archive::LOAD, bytes);
+        uint64_t count;
+        archive(ar, interval);
+        archive(ar, end);
+        archive(ar, count);
+        processes.resize(count);
+        for (auto &entry : processes) archive(ar, entry);
+        archive(ar, snapshots);
+    } catch (const std::exception &e) {
+        std::cerr << "Error: the index of " << path << " is damaged (" << e.what() << ")" << std::endl;
+        return false;
+    }
+    return true;
+}
+
+std::vector<PCB> trace_store_reader::table_at(unsigned int time, size_t &terminated) const {
+    std::vector<stored_process> table(processes.size());
+    std::vector<bool> is_live(processes.size(), false);
+
+    // the last snapshot at or before time, and its events up to the next snapshot (all later than time)
+    auto next = std::upper_bound(snapshots.begin(), snapshots.end(), time,
+                                 [](unsigned int t, const std::pair<uint32_t, uint64_t> &s){ return t < s.first; });
+    if (next != snapshots.begin()) {
+        uint64_t from = std::prev(next)->second, to = next == snapshots.end() ? footer : next->second;
+        std::string bytes(to - from, '\0');
+        std::ifstream file(path, std::ios::binary);
+        file.seekg(from).read(&bytes[0], bytes.size());
+        state_archive ar(state_archive::LOAD, bytes);
+
+        char kind;
+        uint32_t snapshot_time, count;
+        archive(ar, kind);
+        archive(ar, snapshot_time);
+        archive(ar, count);
+        for (uint32_t i = 0; i < count; i++) {
+            stored_process p;
+            archive(ar, p);
+            table[p.index] = p;
+            is_live[p.index] = true;
+        }
+        while (!ar.exhausted()) {
+            uint32_t event_time, index;
+            int32_t value;
+            archive(ar, kind);
+            archive(ar, event_time);
+            archive(ar, index);
+            archive(ar, value);
+            if (event_time > time) break;
+            stored_process &p = table[index];
+            if (kind == 'M') {
+                p.partition = value;
+                continue;
+            }
+            if (!is_live[index]) p = {index, NOT_ASSIGNED, p.partition, -1, 0, 0};
+            is_live[index] = value != TERMINATED;
+            if (p.state == RUNNING) p.cpu_used += event_time - p.since;
+            if (value == RUNNING && p.start_time == -1) p.start_time = event_time;
+            p.state = value;
+            p.since = event_time;
+        }
+    }
+
+    std::vector<PCB> result;
+    terminated = 0;
+    for (size_t i = 0; i < processes.size(); i++) {
+        const stored_workload_entry &entry = processes[i];
+        if (entry.finished <= time) terminated++;
+        bool pending = !is_live[i] && entry.arrival_time <= time && (entry.admitted == NEVER || entry.admitted > time);
+        if (!is_live[i] && !pending) continue;
+
+        PCB process{};
+        process.PID = entry.PID;
+        process.size = entry.size;
+        process.arrival_time = entry.arrival_time;
+        process.processing_time = entry.processing_time;
+        process.remaining_time = entry.processing_time;
+        process.start_time = -1;
+        process.partition_number = -1;
+        process.state = NOT_ASSIGNED;
+        if (is_live[i]) {
+            const stored_process &p = table[i];
+            uint32_t used = p.cpu_used + (p.state == RUNNING ? time - p.since : 0);
+            process.state = (states)p.state;
+            process.partition_number = p.partition;
+            process.start_time = p.start_time;
+            process.remaining_time -= std::min(used, entry.processing_time);
+        }
+        result.push_back(process);
+    }
+    std::sort(result.begin(), result.end(), [](const PCB &a, const PCB &b){ return a.PID < b.PID; });
+    return result;
+}
+
+//-------------------------------------------GANTT CHARTS----------------------------------------------
+
+void gantt_grid::clear() {
+    scale = 1;
+    group = 1;
+    processes = 0;
+    std::fill(cells.begin(), cells.end(), cell{});
+}
+
+void gantt_grid::add_process() {
+    if (processes == rows * group) merge_rows();
+    processes++;
+}
+
+void gantt_grid::add(size_t process, unsigned int from, unsigned int to, shown_states state) {
+    if (to <= from) return;
+    while (to > columns * scale) widen_columns();
+    cell *row = &cells[process / group * columns];
+    for (uint64_t column = from / scale; column * scale < to; column++) {
+        uint64_t start = std::max<uint64_t>(from, column * scale), stop = std::min<uint64_t>(to, (column + 1) * scale);
+        row[column][state] += stop - start;
+    }
+}
+
+void gantt_grid::widen_columns() {
+    for (size_t r = 0; r < rows; r++) {
+        cell *row = &cells[r * columns];
+        for (size_t c = 0; c < columns / 2; c++) {
+            for (int s = 0; s < SHOWN_STATES; s++) row[c][s] = row[2 * c][s] + row[2 * c + 1][s];
+        }
+        std::fill(row + columns / 2, row + columns, cell{});
+    }
+    scale *= 2;
+}
+
+void gantt_grid::merge_rows() {
+    for (size_t r = 0; r < rows / 2; r++) {
+        for (size_t c = 0; c < columns; c++) {
+            for (int s = 0; s < SHOWN_STATES; s++) cells[r * columns + c][s] = cells[2 * r * columns + c][s] + cells[(2 * r + 1) * columns + c][s];
+        }
+    }
+    std::fill(cells.begin() + rows / 2 * columns, cells.end(), cell{});
+    group *= 2;
+}
+
+gantt_grid::shown_states gantt_grid::dominant(const cell &c, double &fill) const {
+    int best = 0;
+    uint64_t total = 0;
+    for (int s = 0; s < SHOWN_STATES; s++) {
+        if (c[s] > c[best]) best = s;
+        total += c[s];
+    }
+    // process-ms per ms of the cell: a row of several processes is full while any of them is shown
+    fill = std::min(1.0, (double)total / scale);
+    return total == 0 ? SHOWN_STATES : (shown_states)best;
+}
+
+std::string gantt_grid::row_label(size_t row, const std::vector<int> &PIDs) const {
+    // rows group processes in order of appearance, not of PID: P<first> and how many more
+    size_t first = row * group, count = std::min(processes, first + group) - first;
+    return "P" + std::to_string(PIDs[first]) + (count > 1 ? " +" + std::to_string(count - 1) : "");
+}
+
+std::string gantt_grid::svg(const std::vector<int> &PIDs, unsigned int end) const {
+    const char* const colors[SHOWN_STATES] = {"#2ca02c", "#ff7f0e", "#1f77b4"};
+    const char* const names[SHOWN_STATES] = {"RUNNING", "READY", "WAITING"};
+    const size_t margin = 110, top = 24, axis = 24;
+
+    size_t used_rows = (processes + group - 1) / group;
+    size_t used_columns = std::max<uint64_t>(1, std::min<uint64_t>(columns, (end + scale - 1) / scale));
+    size_t row_height = std::max<size_t>(1, std::min<size_t>(16, 800 / std::max<size_t>(used_rows, 1)));
+    size_t width = std::max<size_t>(margin + used_columns + 20, margin + 480), height = top + used_rows * row_height + axis;
+
+    std::ostringstream out;
+    out << "<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"" << width << "\" height=\"" << height
+        << "\" font-family=\"monospace\" font-size=\"10\" shape-rendering=\"crispEdges\">\n";
+    out << "<rect width=\"100%\" height=\"100%\" fill=\"white\"/>\n";
+    for (int s = 0; s < SHOWN_STATES; s++) {
+        out << "<rect x=\"" << margin + 90 * s << "\" y=\"6\" width=\"10\" height=\"10\" fill=\"" << colors[s] << "\"/>"
+            << "<text x=\"" << margin + 90 * s + 14 << "\" y=\"15\">" << names[s] << "</text>\n";
+    }
+    out << "<text x=\"" << margin + 300 << "\" y=\"15\">" << scale << " ms/px, " << group << " process(es)/row</text>\n";
+
+    // one rect per run of cells with the same state and shade
+    for (size_t r = 0; r < used_rows; r++) {
+        size_t y = top + r * row_height;
+        if (row_height >= 8) out << "<text x=\"2\" y=\"" << y + row_height - 2 << "\">" << row_label(r, PIDs) << "</text>\n";
+        const cell *row = &cells[r * columns];
+        for (size_t c = 0; c < used_columns;) {
+            double fill;
+            shown_states state = dominant(row[c], fill);
+            int shade = (int)std::ceil(fill * 4);
+            size_t run = c + 1;
+            for (double next_fill; run < used_columns && dominant(row[run], next_fill) == state && (int)std::ceil(next_fill * 4) == shade; run++) {}
+            if (state != SHOWN_STATES) {
+                out << "<rect x=\"" << margin + c << "\" y=\"" << y << "\" width=\"" << run - c << "\" height=\"" << row_height
+                    << "\" fill=\"" << colors[state] << "\"";
+                if (shade < 4) out << " fill-opacity=\"" << shade / 4.0 << "\"";
+                out << "/>\n";
+            }
+            c = run;
+        }
+    }
+
+    size_t axis_y = top + used_rows * row_height;
+    out << "<line x1=\"" << margin << "\" y1=\"" << axis_y << "\" x2=\"" << margin + used_columns << "\" y2=\"" << axis_y << "\" stroke=\"black\"/>\n";
+    size_t ticks = std::max<size_t>(1, std::min<size_t>(10, used_columns / 60));
+    for (size_t tick = 0; tick <= ticks; tick++) {
+        size_t x = used_columns * tick / ticks;
+        out << "<line x1=\"" << margin + x << "\" y1=\"" << axis_y << "\" x2=\"" << margin + x << "\" y2=\"" << axis_y + 4 << "\" stroke=\"black\"/>"
+            << "<text x=\"" << margin + x << "\" y=\"" << axis_y + 16 << "\" text-anchor=\"middle\">" << x * scale << "</text>\n";
+    }
+    out << "</svg>\n";
+    return out.str();
+}
+
+std::string gantt_grid::ascii(const std::vector<int> &PIDs, unsigned int end) const {
+    const char symbols[SHOWN_STATES + 1] = {'#', '=', '.', ' '};
+    const int label_width = 14;
+
+    size_t used_rows = (processes + group - 1) / group;
+    size_t used_columns = std::max<uint64_t>(1, std::min<uint64_t>(columns, (end + scale - 1) / scale));
+
+    std::ostringstream out;
+    out << "0 to " << end << " ms, " << scale << " ms per column, " << group << " process(es) per row;"
+        << " # RUNNING, = READY, . WAITING" << std::endl;
+    for (size_t r = 0; r < used_rows; r++) {
+        std::string line(used_columns, ' ');
+        for (size_t c = 0; c < used_columns; c++) {
+            double fill;
+            line[c] = symbols[dominant(cells[r * columns + c], fill)];
+        }
+        out << std::setw(label_width) << std::left << row_label(r, PIDs) << std::right << "|" << line << "|" << std::endl;
+    }
+    return out.str();
+}
+
+void gantt_chart::close(process_track &track, unsigned int time) {
+    gantt_grid::shown_states shown;
+    switch (track.state) {
+        case RUNNING:   shown = gantt_grid::SHOWN_RUNNING; break;
+        case READY:     shown = gantt_grid::SHOWN_READY; break;
+        case WAITING:   shown = gantt_grid::SHOWN_WAITING; break;
+        default: return;
+    }
+    image.add(track.index, track.since, time, shown);
+    text.add(track.index, track.since, time, shown);
+}
+
+void gantt_chart::transition(unsigned int time, int PID, states old_state, states new_state) {
+    (void)old_state;
+    end = std::max(end, time);
+    auto found = tracks.find(PID);
+    if (found == tracks.end()) {
+        tracks[PID] = {PIDs.size(), new_state, time};
+        PIDs.push_back(PID);
+        image.add_process();
+        text.add_process();
+        return;
+    }
+    close(found->second, time);
+    found->second.state = new_state;
+    found->second.since = time;
+}
+
+void gantt_chart::restart() {
+    image.clear();
+    text.clear();
+    tracks.clear();
+    PIDs.clear();
+    end = 0;
+}
+
+//Processes still going when the trace ends are drawn up to its last transition
+void gantt_chart::finish() {
+    for (auto &track : tracks) {
+        close(track.second, end);
+        track.second.since = end;
+    }
+}
+
+//------------------------------------HELPERS FOR THE PCB-COPY SCHEDULERS---------------------------------
+
+//Convert a list of strings into a PCB
+//Columns: PID, size, arrival time, processing time, I/O frequency, I/O duration[, nice[, deadline[, tickets[, device]]]]
+PCB add_process(std::vector<std::string> tokens) {
+    PCB process;
+    process.PID = std::stoi(tokens[0]);
+    process.size = std::stoi(tokens[1]);
+    process.arrival_time = std::stoi(tokens[2]);
+    process.processing_time = std::stoi(tokens[3]);
+    process.remaining_time = std::stoi(tokens[3]);
+    process.io_freq = std::stoi(tokens[4]);
+    process.io_duration = std::stoi(tokens[5]);
+    process.nice = tokens.size() > 6 ? std::stoi(tokens[6]) : 0;
+    process.deadline = tokens.size() > 7 ? std::stoi(tokens[7]) : 0;
+    process.tickets = tokens.size() > 8 ? std::stoi(tokens[8]) : 100;
+    process.device = tokens.size() > 9 ? std::stoi(tokens[9]) : 0;
+    process.start_time = -1;
+    process.partition_number = -1;
+    process.state = NOT_ASSIGNED;
+
+    return process;
+}
+
+//Returns true if all processes in the queue have terminated
+bool all_process_terminated(std::vector<PCB> processes) {
+
+    for(auto process : processes) {
+        if(process.state != TERMINATED) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+//Terminates a given process
+void Simulator::terminate_process(PCB &running, std::vector<PCB> &job_queue, unsigned int current_time) {
+    running.remaining_time = 0;
+    running.state = TERMINATED;
+    free_memory(running, current_time);
+    sync_queue(job_queue, running);
+}
+
+//set the process in the ready queue to runnning
+void run_process(PCB &running, std::vector<PCB> &job_queue, std::vector<PCB> &ready_queue, unsigned int current_time) {
+    running = ready_queue.back();
+    ready_queue.pop_back();
+    running.start_time = current_time;
+    running.state = RUNNING;
+    sync_queue(job_queue, running);
+}
+
+void idle_CPU(PCB &running) {
+    running.start_time = 0;
+    running.processing_time = 0;
+    running.remaining_time = 0;
+    running.arrival_time = 0;
+    running.io_duration = 0;
+    running.io_freq = 0;
+    running.partition_number = 0;
+    running.size = 0;
+    running.state = NOT_ASSIGNED;
+    running.nice = 0;
+    running.deadline = 0;
+    running.tickets = 0;
+    running.device = 0;
+    running.PID = -1;
+}
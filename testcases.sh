@@ -16,14 +16,55 @@ for input in input_files/*.txt; do
     # EP scheduler
     ./bin/interrupts_EP_101268848_101281787 "$input" 
     cp execution.txt "output_files/${filename}_EP.txt"
+    cp metrics.txt "output_files/${filename}_EP_metrics.txt"
 
     # RR scheduler
     ./bin/interrupts_RR_101268848_101281787 "$input"
     cp execution.txt "output_files/${filename}_RR.txt"
+    cp metrics.txt "output_files/${filename}_RR_metrics.txt"
 
     # EP+RR scheduler
     ./bin/interrupts_EP_RR_101268848_101281787 "$input"
     cp execution.txt "output_files/${filename}_EP_RR.txt"
+    cp metrics.txt "output_files/${filename}_EP_RR_metrics.txt"
+
+    # MLFQ scheduler
+    ./bin/interrupts_MLFQ_101268848_101281787 "$input"
+    cp execution.txt "output_files/${filename}_MLFQ.txt"
+    cp metrics.txt "output_files/${filename}_MLFQ_metrics.txt"
+
+    # SRTF scheduler
+    ./bin/interrupts_SRTF_101268848_101281787 "$input" srtf
+    cp execution.txt "output_files/${filename}_SRTF.txt"
+    cp metrics.txt "output_files/${filename}_SRTF_metrics.txt"
+
+    # SJF scheduler
+    ./bin/interrupts_SRTF_101268848_101281787 "$input" sjf
+    cp execution.txt "output_files/${filename}_SJF.txt"
+    cp metrics.txt "output_files/${filename}_SJF_metrics.txt"
+
+    # CFS scheduler
+    ./bin/interrupts_CFS_101268848_101281787 "$input"
+    cp execution.txt "output_files/${filename}_CFS.txt"
+    cp metrics.txt "output_files/${filename}_CFS_metrics.txt"
+
+    # EDF scheduler
+    ./bin/interrupts_EDF_101268848_101281787 "$input"
+    cp execution.txt "output_files/${filename}_EDF.txt"
+    cp metrics.txt "output_files/${filename}_EDF_metrics.txt"
+
+    # Stride scheduler
+    ./bin/interrupts_STRIDE_101268848_101281787 "$input" stride
+    cp execution.txt "output_files/${filename}_STRIDE.txt"
+    cp metrics.txt "output_files/${filename}_STRIDE_metrics.txt"
+
+    # Lottery scheduler
+    ./bin/interrupts_STRIDE_101268848_101281787 "$input" lottery
+    cp execution.txt "output_files/${filename}_LOTTERY.txt"
+    cp metrics.txt "output_files/${filename}_LOTTERY_metrics.txt"
 done
 
+# every policy side by side, per workload and overall
+./bin/interrupts_REPORT_101268848_101281787 input_files output_files output_files/report
+
 echo "All testcases are done running"
@@ -0,0 +1,52 @@
+#include "interrupts_101268848_101281787.hpp"
+#include <random>
+
+// Prints a synthetic workload in the input file format, for the PGO training runs and the benchmarks of the build
+// variants: ./workload_gen <processes> [seed] [--devices=<n>] > workload.txt
+// Sizes fit the fixed partitions, bursts are 5-100 ms with an I/O every 10-50 ms of them, and arrivals are spaced
+// so the CPU stays around 90% busy: queues stay long enough to exercise every policy without growing without
+// bound. Each process also gets a nice value, a deadline (one in four), tickets and, with devices, a device.
+// The same arguments always give the same workload.
+
+const unsigned int GEN_DEFAULT_SEED = 1;
+
+int main(int argc, char** argv) {
+    unsigned int devices = 1;
+    int kept = 1;
+    for (int i = 1; i < argc; i++) {
+        std::string option = argv[i];
+        if (option.rfind("--devices=", 0) == 0) {
+            if (!parse_number("--devices", option.substr(10), devices, 1)) return -1;
+        } else {
+            argv[kept++] = argv[i];
+        }
+    }
+    argc = kept;
+
+    if(argc < 2 || argc > 3) {
+        std::cout << "ERROR!\nExpected 1 or 2 arguments, received " << argc - 1 << std::endl;
+        std::cout << "To run the program, do: ./workload_gen <processes> [seed] [--devices=<n>]" << std::endl;
+        return -1;
+    }
+    unsigned long processes, seed = GEN_DEFAULT_SEED;
+    if (!parse_number("processes", argv[1], processes)) return -1;
+    if (argc == 3 && !parse_number("seed", argv[2], seed)) return -1;
+    std::mt19937 random(seed);
+    auto uniform = [&](int low, int high){ return std::uniform_int_distribution<int>(low, high)(random); };
+
+    std::ostringstream workload;
+    unsigned int arrival = 0;
+    for (unsigned long p = 0; p < processes; p++) {
+        int processing_time = uniform(5, 100);
+        int io_freq = uniform(10, 50);
+        int io_duration = uniform(1, 20);
+        int deadline = uniform(0, 3) == 0 ? processing_time * uniform(2, 10) : 0;
+        workload << p + 1 << ", " << uniform(1, 25) << ", " << arrival << ", " << processing_time << ", " << io_freq << ", "
+                 << io_duration << ", " << uniform(-5, 5) << ", " << deadline << ", " << uniform(50, 200) << ", "
+                 << uniform(0, devices - 1) << "\n";
+        // mean burst 52.5 ms against a mean gap of 58 ms
+        arrival += uniform(0, 116);
+    }
+    std::cout << workload.str();
+    return 0;
+}